@@ -0,0 +1,81 @@
+#include "adjudication_queue.h"
+
+namespace diplomacy {
+
+ReadinessTracker::ReadinessTracker(int powers)
+    : phaseStart_(0), active_(powers > 0 ? powers : 0), complete_(powers > 0 ? powers : 0),
+      wait_(powers > 0 ? powers : 0), activeCount_(0), readyCount_(0) {}
+
+void ReadinessTracker::StartPhase(const std::string& phase, int64_t startMs) {
+  phase_ = phase;
+  phaseStart_ = startMs;
+  active_.assign(active_.size(), false);
+  complete_.assign(complete_.size(), false);
+  activeCount_ = 0;
+  readyCount_ = 0;
+}
+
+void ReadinessTracker::SetActive(int power, bool active) {
+  if (active_[power] == active) {
+    return;
+  }
+  readyCount_ -= Counted(power);
+  active_[power] = active;
+  activeCount_ += active ? 1 : -1;
+  readyCount_ += Counted(power);
+}
+
+void ReadinessTracker::SetComplete(int power, bool complete) {
+  readyCount_ -= Counted(power);
+  complete_[power] = complete;
+  readyCount_ += Counted(power);
+}
+
+void ReadinessTracker::SetWait(int power, bool wait) {
+  readyCount_ -= Counted(power);
+  wait_[power] = wait;
+  readyCount_ += Counted(power);
+}
+
+void AdjudicationQueue::Schedule(const std::string& gameId, int64_t dueMs) {
+  auto it = due_.find(gameId);
+  if (it != due_.end()) {
+    if (it->second == dueMs) {
+      return;
+    }
+    byDue_.erase({it->second, gameId});
+    it->second = dueMs;
+  } else {
+    due_.emplace(gameId, dueMs);
+  }
+  byDue_.insert({dueMs, gameId});
+}
+
+void AdjudicationQueue::Cancel(const std::string& gameId) {
+  auto it = due_.find(gameId);
+  if (it != due_.end()) {
+    byDue_.erase({it->second, gameId});
+    due_.erase(it);
+  }
+}
+
+bool AdjudicationQueue::Contains(const std::string& gameId) const {
+  return due_.count(gameId) > 0;
+}
+
+std::vector<std::string> AdjudicationQueue::PopDue(int64_t nowMs) {
+  std::vector<std::string> games;
+  while (!byDue_.empty() && byDue_.begin()->first <= nowMs) {
+    games.push_back(byDue_.begin()->second);
+    due_.erase(byDue_.begin()->second);
+    byDue_.erase(byDue_.begin());
+  }
+  return games;
+}
+
+void AdjudicationQueue::Clear() {
+  byDue_.clear();
+  due_.clear();
+}
+
+}  // namespace diplomacy
@@ -0,0 +1,79 @@
+#ifndef ADJUDICATION_QUEUE_H
+#define ADJUDICATION_QUEUE_H
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace diplomacy {
+
+// Which powers of one game are ready for their current phase to be
+// adjudicated. A power is ready once its orders are complete, unless its
+// player has asked to wait; a wait lasts until it is lifted. The game
+// waits only for its active powers, and the number of those that are
+// ready is kept as each changes, so one power's submission costs the same
+// however many others there are.
+class ReadinessTracker {
+ public:
+  explicit ReadinessTracker(int powers = 0);
+
+  // Begin a phase at `startMs`: nobody is active or has complete orders yet
+  void StartPhase(const std::string& phase, int64_t startMs);
+
+  void SetActive(int power, bool active);
+  void SetComplete(int power, bool complete);
+  void SetWait(int power, bool wait);
+
+  bool Active(int power) const { return active_[power]; }
+  bool Ready(int power) const { return complete_[power] && !wait_[power]; }
+
+  // Whether there are active powers and every one of them is ready
+  bool AllReady() const { return activeCount_ > 0 && readyCount_ == activeCount_; }
+
+  const std::string& Phase() const { return phase_; }
+  int64_t PhaseStart() const { return phaseStart_; }
+
+ private:
+  bool Counted(int power) const { return active_[power] && Ready(power); }
+
+  std::string phase_;
+  int64_t phaseStart_;
+  std::vector<bool> active_;
+  std::vector<bool> complete_;
+  std::vector<bool> wait_;
+  int activeCount_;
+  int readyCount_;  // Active powers that are ready
+};
+
+// Games due to be adjudicated, earliest first. A game is scheduled once
+// all its active powers are ready, no sooner than its minimum wait allows,
+// and the deadline processor takes the games whose time has come. A game
+// is in the queue at most once. Each engine's queue is only used from its
+// own JavaScript thread, so it takes no lock.
+class AdjudicationQueue {
+ public:
+  AdjudicationQueue() {}
+
+  // Queue a game for `dueMs`, or move it to `dueMs` if already queued,
+  // later as well as sooner
+  void Schedule(const std::string& gameId, int64_t dueMs);
+
+  void Cancel(const std::string& gameId);
+  bool Contains(const std::string& gameId) const;
+
+  // Remove and return the games due at or before `nowMs`, earliest first
+  std::vector<std::string> PopDue(int64_t nowMs);
+
+  void Clear();
+
+ private:
+  std::set<std::pair<int64_t, std::string>> byDue_;
+  std::unordered_map<std::string, int64_t> due_;
+};
+
+}  // namespace diplomacy
+
+#endif // ADJUDICATION_QUEUE_H
@@ -0,0 +1,1214 @@
+#include <algorithm>
+#include <cctype>
+#include <deque>
+#include <sstream>
+#include "adjudicator.h"
+#include "rules.h"
+
+namespace diplomacy {
+
+Board::Board(const Map& map) : Board(map, RulesFor<StandardRules>()) {}
+
+Board::Board(const Map& map, const RuleSet& rules)
+    : year(1901), season(SEASON_SPRING), phase(PHASE_MOVEMENT),
+      units(map.ProvinceCount(), Unit{-1, UNIT_ARMY, COAST_NONE}),
+      owners(map.ProvinceCount(), -1), map_(&map), rules_(&rules) {
+  for (ProvinceId id = 0; id < map.ProvinceCount(); ++id) {
+    const Province& province = map.GetProvince(id);
+    if (province.supplyCenter) {
+      owners[id] = static_cast<int8_t>(province.homePower);
+    }
+  }
+  for (const StartingUnit& unit : map.StartingUnits()) {
+    units[unit.location.province] =
+        Unit{static_cast<int8_t>(unit.power), unit.type, unit.location.coast};
+  }
+}
+
+std::string Board::PhaseName() const {
+  static const char seasons[] = {'S', 'F', 'W'};
+  static const char phases[] = {'M', 'R', 'A'};
+  std::string name(1, seasons[season]);
+  name += std::to_string(year);
+  name += phases[phase];
+  return name;
+}
+
+int Board::UnitCount(int power) const {
+  int count = 0;
+  for (const Unit& unit : units) {
+    if (unit.power == power) {
+      count++;
+    }
+  }
+  return count;
+}
+
+int Board::CenterCount(int power) const {
+  int count = 0;
+  for (int8_t owner : owners) {
+    if (owner == power) {
+      count++;
+    }
+  }
+  return count;
+}
+
+int Board::AdjustmentCount(int power) const {
+  return CenterCount(power) - UnitCount(power);
+}
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Order parsing
+
+class OrderParser {
+ public:
+  OrderParser(const Map& map, const std::string& text) : map_(map), pos_(0) {
+    std::string spaced;
+    for (size_t i = 0; i < text.size(); ++i) {
+      char c = static_cast<char>(std::toupper(static_cast<unsigned char>(text[i])));
+      if (c == '-' && i + 1 < text.size() && text[i + 1] == '>') {
+        spaced += " - ";
+        ++i;
+      } else if (c == '-' || c == ':' || c == ',') {
+        spaced += ' ';
+        spaced += c;
+        spaced += ' ';
+      } else if (c != '.') {
+        spaced += c;
+      }
+    }
+    std::istringstream in(spaced);
+    std::string token;
+    while (in >> token) {
+      tokens_.push_back(token);
+    }
+  }
+
+  bool AtEnd() const { return pos_ >= tokens_.size(); }
+  const std::string& Peek() const { return tokens_[pos_]; }
+  void Skip(size_t count) { pos_ += count; }
+
+  // The token `ahead` places on, or "" past the end
+  std::string Lookahead(size_t ahead) const {
+    return pos_ + ahead < tokens_.size() ? tokens_[pos_ + ahead] : "";
+  }
+
+  // Consume the next token if it is one of `words`
+  bool Accept(std::initializer_list<const char*> words) {
+    if (AtEnd()) {
+      return false;
+    }
+    for (const char* word : words) {
+      if (tokens_[pos_] == word) {
+        pos_++;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Optional unit type; returns false if none was given
+  bool AcceptUnitType(UnitType* type) {
+    if (Accept({"A", "ARMY"})) {
+      *type = UNIT_ARMY;
+      return true;
+    }
+    if (Accept({"F", "FLEET"})) {
+      *type = UNIT_FLEET;
+      return true;
+    }
+    return false;
+  }
+
+  // A location, trying the longest run of words first so that full names
+  // like "North Sea" work, then an optional trailing coast
+  bool AcceptLocation(Location* location, bool* coastGiven) {
+    for (size_t length = std::min<size_t>(3, tokens_.size() - pos_); length > 0; --length) {
+      std::string name = tokens_[pos_];
+      for (size_t i = 1; i < length; ++i) {
+        name += " " + tokens_[pos_ + i];
+      }
+      if (!map_.ParseLocation(name, location)) {
+        continue;
+      }
+      pos_ += length;
+      *coastGiven = location->coast != COAST_NONE;
+      if (!AtEnd() && !*coastGiven) {
+        std::string coast = tokens_[pos_];
+        if (coast.front() == '/' || coast.front() == '(') {
+          coast = coast.substr(1);
+        }
+        if (coast == "NC" || coast == "SC" || coast == "EC" ||
+            coast == "NC)" || coast == "SC)" || coast == "EC)") {
+          Location withCoast;
+          if (map_.ParseLocation(name + "/" + coast, &withCoast)) {
+            *location = withCoast;
+            *coastGiven = true;
+            pos_++;
+          }
+        }
+      }
+      return true;
+    }
+    return false;
+  }
+
+ private:
+  const Map& map_;
+  std::vector<std::string> tokens_;
+  size_t pos_;
+};
+
+bool fail(std::string* error, const char* message) {
+  if (error) {
+    *error = message;
+  }
+  return false;
+}
+
+bool coastal(const Map& map, ProvinceId province) {
+  return map.GetProvince(province).type == PROVINCE_COAST;
+}
+
+// Resolve the coast a fleet at `from` moves to in `to`
+bool fleetDestination(const Map& map, const Location& from, Location* to,
+                      bool coastGiven, std::string* error) {
+  const Province& province = map.GetProvince(to->province);
+  if (province.coasts.empty() || coastGiven) {
+    if (province.coasts.empty()) {
+      to->coast = COAST_NONE;
+    }
+    if (!map.FleetAdjacent(from, *to)) {
+      return fail(error, "Fleet cannot move there");
+    }
+    return true;
+  }
+  if (!map.CanReach(UNIT_FLEET, from, to->province)) {
+    return fail(error, "Fleet cannot move there");
+  }
+  to->coast = map.SoleCoast(from, to->province);
+  if (to->coast == COAST_NONE) {
+    return fail(error, "Coast must be specified");
+  }
+  return true;
+}
+
+// The unit of `power` (or anyone's, for -1) standing at `location`
+bool findUnit(const Board& board, int power, bool typeGiven, UnitType type,
+              const Location& location, Order* order, std::string* error) {
+  const Unit& unit = board.units[location.province];
+  if (unit.power < 0) {
+    return fail(error, "No unit there");
+  }
+  if (power >= 0 && unit.power != power) {
+    return fail(error, "Unit belongs to another power");
+  }
+  if (typeGiven && unit.type != type) {
+    return fail(error, "Wrong unit type");
+  }
+  order->power = unit.power;
+  order->unitType = unit.type;
+  order->unit = Location{location.province, unit.coast};
+  return true;
+}
+
+bool parseMovement(const Board& board, OrderParser& parser, int power,
+                   Order* order, std::string* error) {
+  const Map& map = board.GetMap();
+  UnitType type = UNIT_ARMY;
+  bool typeGiven = parser.AcceptUnitType(&type);
+  Location location;
+  bool coastGiven = false;
+  if (!parser.AcceptLocation(&location, &coastGiven)) {
+    return fail(error, "Unknown province");
+  }
+  if (!findUnit(board, power, typeGiven, type, location, order, error)) {
+    return false;
+  }
+
+  if (parser.AtEnd() || parser.Accept({"H", "HOLD", "HOLDS", "STAND", "STANDS"})) {
+    order->type = ORDER_HOLD;
+  } else if (parser.Accept({"-", "M", "MOVE", "MOVES", "TO"})) {
+    order->type = ORDER_MOVE;
+    // "A LON-NTH-NWY" names the convoy route; only the end matters
+    int steps = 0;
+    do {
+      if (!parser.AcceptLocation(&order->to, &coastGiven)) {
+        return fail(error, "Unknown province");
+      }
+      steps++;
+    } while (parser.Accept({"-"}));
+    if (parser.Accept({"VIA", "BY"})) {
+      parser.Accept({"CONVOY"});
+      order->viaConvoy = true;
+    }
+    order->viaConvoy = order->viaConvoy || steps > 1;
+
+    if (order->to.province == order->unit.province) {
+      return fail(error, "Unit cannot move to its own province");
+    }
+    if (order->unitType == UNIT_FLEET) {
+      if (order->viaConvoy) {
+        return fail(error, "Fleets cannot be convoyed");
+      }
+      return fleetDestination(map, order->unit, &order->to, coastGiven, error);
+    }
+    order->to.coast = COAST_NONE;
+    if (!order->viaConvoy && map.ArmyAdjacent(order->unit.province, order->to.province)) {
+      return true;
+    }
+    if (!coastal(map, order->unit.province) || !coastal(map, order->to.province)) {
+      return fail(error, "Army cannot move there");
+    }
+    order->viaConvoy = true;
+  } else if (parser.Accept({"S", "SUP", "SUPPORT", "SUPPORTS"})) {
+    order->type = ORDER_SUPPORT;
+    UnitType supportedType;
+    parser.AcceptUnitType(&supportedType);
+    Location supported;
+    if (!parser.AcceptLocation(&supported, &coastGiven)) {
+      return fail(error, "Unknown province");
+    }
+    order->from = supported.province;
+    order->to = Location{supported.province, COAST_NONE};
+    if (parser.Accept({"-", "M", "MOVE", "TO"})) {
+      if (!parser.AcceptLocation(&order->to, &coastGiven)) {
+        return fail(error, "Unknown province");
+      }
+      order->to.coast = COAST_NONE;
+    } else {
+      parser.Accept({"H", "HOLD"});
+    }
+    if (order->from == order->unit.province) {
+      return fail(error, "Unit cannot support itself");
+    }
+    if (!map.CanReach(order->unitType, order->unit, order->to.province)) {
+      return fail(error, "Unit cannot support there");
+    }
+  } else if (parser.Accept({"C", "CON", "CONVOY", "CONVOYS", "T", "TRANSPORT"})) {
+    order->type = ORDER_CONVOY;
+    UnitType convoyedType = UNIT_ARMY;
+    parser.AcceptUnitType(&convoyedType);
+    Location army;
+    if (!parser.AcceptLocation(&army, &coastGiven) ||
+        !parser.Accept({"-", "M", "TO"}) ||
+        !parser.AcceptLocation(&order->to, &coastGiven)) {
+      return fail(error, "Convoy needs an army and a destination");
+    }
+    order->from = army.province;
+    order->to.coast = COAST_NONE;
+    if (order->unitType != UNIT_FLEET ||
+        map.GetProvince(order->unit.province).type != PROVINCE_SEA) {
+      return fail(error, "Only fleets at sea can convoy");
+    }
+    if (convoyedType != UNIT_ARMY || !coastal(map, order->from) ||
+        !coastal(map, order->to.province)) {
+      return fail(error, "Only armies can be convoyed between coasts");
+    }
+  } else {
+    return fail(error, "Unknown order");
+  }
+  return parser.AtEnd() || fail(error, "Unexpected text after order");
+}
+
+bool parseRetreat(const Board& board, OrderParser& parser, int power,
+                  Order* order, std::string* error) {
+  UnitType type = UNIT_ARMY;
+  bool typeGiven = parser.AcceptUnitType(&type);
+  Location location;
+  bool coastGiven = false;
+  if (!parser.AcceptLocation(&location, &coastGiven)) {
+    return fail(error, "Unknown province");
+  }
+
+  const DislodgedUnit* unit = nullptr;
+  for (const DislodgedUnit& dislodged : board.dislodged) {
+    if (dislodged.location.province == location.province) {
+      unit = &dislodged;
+    }
+  }
+  if (!unit) {
+    return fail(error, "No dislodged unit there");
+  }
+  if (power >= 0 && unit->power != power) {
+    return fail(error, "Unit belongs to another power");
+  }
+  if (typeGiven && unit->type != type) {
+    return fail(error, "Wrong unit type");
+  }
+  order->power = unit->power;
+  order->unitType = unit->type;
+  order->unit = unit->location;
+
+  if (parser.Accept({"D", "DISBAND", "DISBANDS"})) {
+    order->type = ORDER_DISBAND;
+  } else if (parser.Accept({"R", "RET", "RETREAT", "RETREATS", "-", "M", "MOVE", "TO"})) {
+    order->type = ORDER_RETREAT;
+    if (!parser.AcceptLocation(&order->to, &coastGiven)) {
+      return fail(error, "Unknown province");
+    }
+    // Match against the retreats worked out at the end of the movement phase
+    int matches = 0;
+    Location match = order->to;
+    for (const Location& retreat : unit->retreats) {
+      if (retreat.province == order->to.province &&
+          (!coastGiven || retreat.coast == order->to.coast)) {
+        match = retreat;
+        matches++;
+      }
+    }
+    if (matches == 0) {
+      return fail(error, "Unit cannot retreat there");
+    }
+    if (matches > 1) {
+      return fail(error, "Coast must be specified");
+    }
+    order->to = match;
+  } else {
+    return fail(error, "Unknown order");
+  }
+  return parser.AtEnd() || fail(error, "Unexpected text after order");
+}
+
+// Whether `power` may build in `province` under Rules
+template <class Rules>
+bool canBuild(const Board& board, int power, ProvinceId province) {
+  const Province& center = board.GetMap().GetProvince(province);
+  return center.supplyCenter && board.owners[province] == power && !board.Occupied(province) &&
+         (Rules::kBuildAnywhere || center.homePower == power);
+}
+
+template <class Rules>
+bool parseAdjustment(const Board& board, OrderParser& parser, int power,
+                     Order* order, std::string* error) {
+  const Map& map = board.GetMap();
+  if (parser.Accept({"W", "WAIVE", "WAIVES"})) {
+    if (power < 0) {
+      return fail(error, "Waive needs a power");
+    }
+    order->type = ORDER_WAIVE;
+    order->power = power;
+    return parser.AtEnd() || fail(error, "Unexpected text after order");
+  }
+
+  bool build = parser.Accept({"B", "BUILD", "BUILDS"});
+  bool remove = !build && parser.Accept({"R", "REMOVE", "REMOVES", "D", "DISBAND", "DISBANDS"});
+  UnitType type = UNIT_ARMY;
+  bool typeGiven = parser.AcceptUnitType(&type);
+  Location location;
+  bool coastGiven = false;
+  if (!parser.AcceptLocation(&location, &coastGiven)) {
+    return fail(error, "Unknown province");
+  }
+  if (!build && !remove) {
+    // "A PAR BUILD" and "F LON REMOVE" forms
+    build = parser.Accept({"B", "BUILD", "BUILDS"});
+    remove = !build && parser.Accept({"R", "REMOVE", "REMOVES", "D", "DISBAND", "DISBANDS"});
+  }
+  if (!parser.AtEnd()) {
+    return fail(error, "Unexpected text after order");
+  }
+
+  if (remove) {
+    order->type = ORDER_REMOVE;
+    if (!findUnit(board, power, typeGiven, type, location, order, error)) {
+      return false;
+    }
+    if (board.AdjustmentCount(order->power) >= 0) {
+      return fail(error, "No removals due");
+    }
+    return true;
+  }
+  if (!build) {
+    return fail(error, "Unknown order");
+  }
+
+  const Province& province = map.GetProvince(location.province);
+  order->type = ORDER_BUILD;
+  if (power >= 0) {
+    order->power = power;
+  } else {
+    order->power = Rules::kBuildAnywhere ? board.owners[location.province] : province.homePower;
+  }
+  order->unitType = type;
+  order->unit = location;
+  if (!typeGiven) {
+    return fail(error, "Unit type must be specified");
+  }
+  if (!province.supplyCenter || board.owners[location.province] != order->power ||
+      (!Rules::kBuildAnywhere && province.homePower != order->power)) {
+    return fail(error, Rules::kBuildAnywhere ? "Can only build in owned centers"
+                                             : "Can only build in owned home centers");
+  }
+  if (board.Occupied(location.province)) {
+    return fail(error, "Province is occupied");
+  }
+  if (board.AdjustmentCount(order->power) <= 0) {
+    return fail(error, "No builds due");
+  }
+  if (type == UNIT_FLEET && !province.coasts.empty() && !coastGiven) {
+    return fail(error, "Coast must be specified");
+  }
+  if (!map.CanOccupy(type, location)) {
+    return fail(error, "Unit cannot be built there");
+  }
+  return true;
+}
+
+// ---------------------------------------------------------------------------
+// Movement resolution, after Kruijswijk's guess-and-check algorithm. Each
+// move, support and convoy is a decision keyed by the province of the unit;
+// decisions that depend on themselves are guessed both ways and cycles are
+// settled by the backup rule.
+
+class MovementResolver {
+ public:
+  MovementResolver(const Board& board, const std::vector<Order>& orders)
+      : board_(board), map_(board.GetMap()), count_(board.GetMap().ProvinceCount()),
+        orders_(count_), valid_(count_, true), state_(count_, UNRESOLVED),
+        result_(count_, false), movesTo_(count_), supports_(count_), convoys_(count_) {
+    for (ProvinceId p = 0; p < count_; ++p) {
+      const Unit& unit = board.units[p];
+      orders_[p] = Order{ORDER_HOLD, unit.power, unit.type, Location{p, unit.coast},
+                         NO_PROVINCE, Location{NO_PROVINCE, COAST_NONE}, false};
+    }
+    // Later orders for the same unit replace earlier ones
+    for (const Order& order : orders) {
+      ProvinceId p = order.unit.province;
+      if (order.type <= ORDER_CONVOY && board.units[p].power == order.power) {
+        orders_[p] = order;
+      }
+    }
+
+    for (ProvinceId p = 0; p < count_; ++p) {
+      const Order& order = orders_[p];
+      if (board.units[p].power < 0) {
+        continue;
+      }
+      if (order.type == ORDER_MOVE) {
+        movesTo_[order.to.province].push_back(p);
+      } else if (order.type == ORDER_SUPPORT) {
+        const Order& supported = orders_[order.from];
+        bool holding = supported.type != ORDER_MOVE;
+        valid_[p] = board.units[order.from].power >= 0 &&
+            (order.to.province == order.from ? holding
+                                             : !holding && supported.to.province == order.to.province);
+        if (valid_[p]) {
+          supports_[order.from].push_back(p);
+        }
+      } else if (order.type == ORDER_CONVOY) {
+        const Order& convoyed = orders_[order.from];
+        valid_[p] = board.units[order.from].power >= 0 && convoyed.type == ORDER_MOVE &&
+            convoyed.unitType == UNIT_ARMY && convoyed.viaConvoy &&
+            convoyed.to.province == order.to.province;
+        if (valid_[p]) {
+          convoys_[order.from].push_back(p);
+        }
+      }
+    }
+  }
+
+  const Order& OrderAt(ProvinceId p) const { return orders_[p]; }
+  bool Valid(ProvinceId p) const { return valid_[p]; }
+  const std::vector<ProvinceId>& MovesTo(ProvinceId p) const { return movesTo_[p]; }
+
+  bool Resolve(ProvinceId p) {
+    if (state_[p] == RESOLVED) {
+      return result_[p];
+    }
+    if (state_[p] == GUESSING) {
+      if (std::find(deps_.begin(), deps_.end(), p) == deps_.end()) {
+        deps_.push_back(p);
+      }
+      return result_[p];
+    }
+
+    size_t oldCount = deps_.size();
+    result_[p] = false;
+    state_[p] = GUESSING;
+    bool first = Adjudicate(p);
+
+    if (deps_.size() == oldCount) {
+      // Nothing depended on a guess
+      if (state_[p] != RESOLVED) {
+        result_[p] = first;
+        state_[p] = RESOLVED;
+      }
+      return first;
+    }
+
+    if (deps_[oldCount] != p) {
+      // Part of a cycle started further up the stack
+      deps_.push_back(p);
+      result_[p] = first;
+      return first;
+    }
+
+    // Our own cycle: try the other guess
+    ResetFrom(oldCount);
+    result_[p] = true;
+    state_[p] = GUESSING;
+    bool second = Adjudicate(p);
+    if (first == second) {
+      ResetFrom(oldCount);
+      result_[p] = first;
+      state_[p] = RESOLVED;
+      return first;
+    }
+
+    BackupRule(oldCount);
+    return Resolve(p);
+  }
+
+  // Whether a move has a route, through successful convoys if it needs one
+  bool PathOk(ProvinceId p) {
+    const Order& move = orders_[p];
+    if (!move.viaConvoy) {
+      return true;
+    }
+    std::vector<ProvinceId> frontier;
+    std::vector<bool> seen(count_, false);
+    for (ProvinceId fleet : convoys_[p]) {
+      if (Touches(fleet, p) && Resolve(fleet)) {
+        frontier.push_back(fleet);
+        seen[fleet] = true;
+      }
+    }
+    while (!frontier.empty()) {
+      ProvinceId fleet = frontier.back();
+      frontier.pop_back();
+      if (Touches(fleet, move.to.province)) {
+        return true;
+      }
+      for (ProvinceId next : convoys_[p]) {
+        if (!seen[next] && map_.FleetAdjacent(Location{fleet, COAST_NONE},
+                                              Location{next, COAST_NONE}) &&
+            Resolve(next)) {
+          seen[next] = true;
+          frontier.push_back(next);
+        }
+      }
+    }
+    return false;
+  }
+
+ private:
+  enum State : int8_t { UNRESOLVED, GUESSING, RESOLVED };
+
+  bool Adjudicate(ProvinceId p) {
+    switch (orders_[p].type) {
+      case ORDER_MOVE:
+        return AdjudicateMove(p);
+      case ORDER_SUPPORT:
+        return AdjudicateSupport(p);
+      case ORDER_CONVOY:
+        return AdjudicateConvoy(p);
+      default:
+        return true;
+    }
+  }
+
+  bool AdjudicateMove(ProvinceId p) {
+    if (!PathOk(p)) {
+      return false;
+    }
+    ProvinceId target = orders_[p].to.province;
+    int attack = AttackStrength(p);
+    ProvinceId opponent = HeadToHead(p);
+    if (opponent != NO_PROVINCE) {
+      if (attack <= DefendStrength(opponent)) {
+        return false;
+      }
+    } else if (attack <= HoldStrength(target)) {
+      return false;
+    }
+    for (ProvinceId other : movesTo_[target]) {
+      if (other != p && attack <= PreventStrength(other)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool AdjudicateSupport(ProvinceId p) {
+    if (!valid_[p]) {
+      return false;
+    }
+    const Order& support = orders_[p];
+    for (ProvinceId attacker : movesTo_[p]) {
+      if (board_.units[attacker].power == board_.units[p].power || !PathOk(attacker)) {
+        continue;
+      }
+      if (attacker == support.to.province) {
+        // Only cut from where the support is aimed by dislodging
+        if (Resolve(attacker)) {
+          return false;
+        }
+        continue;
+      }
+      return false;
+    }
+    return true;
+  }
+
+  bool AdjudicateConvoy(ProvinceId p) {
+    if (!valid_[p]) {
+      return false;
+    }
+    for (ProvinceId attacker : movesTo_[p]) {
+      if (Resolve(attacker)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // The unit moving the opposite way without a convoy, if any
+  ProvinceId HeadToHead(ProvinceId p) const {
+    const Order& move = orders_[p];
+    ProvinceId target = move.to.province;
+    const Order& other = orders_[target];
+    if (move.viaConvoy || board_.units[target].power < 0 || other.type != ORDER_MOVE ||
+        other.viaConvoy || other.to.province != p) {
+      return NO_PROVINCE;
+    }
+    return target;
+  }
+
+  int HoldStrength(ProvinceId p) {
+    if (board_.units[p].power < 0) {
+      return 0;
+    }
+    if (orders_[p].type == ORDER_MOVE) {
+      return Resolve(p) ? 0 : 1;
+    }
+    int strength = 1;
+    for (ProvinceId supporter : supports_[p]) {
+      if (orders_[supporter].to.province == p && Resolve(supporter)) {
+        strength++;
+      }
+    }
+    return strength;
+  }
+
+  int AttackStrength(ProvinceId p) {
+    if (!PathOk(p)) {
+      return 0;
+    }
+    ProvinceId target = orders_[p].to.province;
+    int defender = -1;
+    if (board_.units[target].power >= 0 &&
+        (orders_[target].type != ORDER_MOVE || HeadToHead(p) != NO_PROVINCE ||
+         !Resolve(target))) {
+      defender = board_.units[target].power;
+    }
+    if (defender == board_.units[p].power) {
+      return 0;
+    }
+    // Supports from the defender's own power never help dislodge it
+    return 1 + MoveSupport(p, defender);
+  }
+
+  int DefendStrength(ProvinceId p) {
+    return 1 + MoveSupport(p, -1);
+  }
+
+  int PreventStrength(ProvinceId p) {
+    if (!PathOk(p)) {
+      return 0;
+    }
+    ProvinceId opponent = HeadToHead(p);
+    if (opponent != NO_PROVINCE && Resolve(opponent)) {
+      return 0;
+    }
+    return 1 + MoveSupport(p, -1);
+  }
+
+  int MoveSupport(ProvinceId p, int excludedPower) {
+    int strength = 0;
+    for (ProvinceId supporter : supports_[p]) {
+      if (orders_[supporter].to.province != orders_[p].to.province ||
+          board_.units[supporter].power == excludedPower) {
+        continue;
+      }
+      if (Resolve(supporter)) {
+        strength++;
+      }
+    }
+    return strength;
+  }
+
+  // Whether a fleet at sea borders a coastal province on any of its coasts
+  bool Touches(ProvinceId sea, ProvinceId province) const {
+    return map_.CanReach(UNIT_FLEET, Location{sea, COAST_NONE}, province);
+  }
+
+  void ResetFrom(size_t oldCount) {
+    for (size_t i = oldCount; i < deps_.size(); ++i) {
+      state_[deps_[i]] = UNRESOLVED;
+    }
+    deps_.resize(oldCount);
+  }
+
+  // Convoy paradoxes fail the convoys involved (Szykman); otherwise the
+  // cycle is circular movement and every move in it succeeds
+  void BackupRule(size_t oldCount) {
+    bool convoys = false;
+    for (size_t i = oldCount; i < deps_.size(); ++i) {
+      convoys = convoys || orders_[deps_[i]].type == ORDER_CONVOY;
+    }
+    for (size_t i = oldCount; i < deps_.size(); ++i) {
+      ProvinceId p = deps_[i];
+      OrderType type = orders_[p].type;
+      if (convoys ? type == ORDER_CONVOY : type == ORDER_MOVE) {
+        result_[p] = !convoys;
+        state_[p] = RESOLVED;
+      } else {
+        state_[p] = UNRESOLVED;
+      }
+    }
+    deps_.resize(oldCount);
+  }
+
+  const Board& board_;
+  const Map& map_;
+  int count_;
+  std::vector<Order> orders_;
+  std::vector<bool> valid_;
+  std::vector<State> state_;
+  std::vector<bool> result_;
+  std::vector<ProvinceId> deps_;
+  std::vector<std::vector<ProvinceId>> movesTo_;
+  std::vector<std::vector<ProvinceId>> supports_;  // Supports given to the unit in each province
+  std::vector<std::vector<ProvinceId>> convoys_;   // Convoys for the army in each province
+};
+
+// Orders are reported by power, then by province
+bool reportOrder(const ResolvedOrder& a, const ResolvedOrder& b) {
+  if (a.order.power != b.order.power) {
+    return a.order.power < b.order.power;
+  }
+  return a.order.unit.province < b.order.unit.province;
+}
+
+void adjudicateMovement(Board* board, const std::vector<Order>& orders, PhaseResult* result) {
+  const Map& map = board->GetMap();
+  int count = map.ProvinceCount();
+  MovementResolver resolver(*board, orders);
+
+  std::vector<bool> moved(count, false);
+  std::vector<ProvinceId> dislodgedBy(count, NO_PROVINCE);
+  for (ProvinceId p = 0; p < count; ++p) {
+    if (board->units[p].power < 0) {
+      continue;
+    }
+    const Order& order = resolver.OrderAt(p);
+    ResolvedOrder resolved = {order, RESULT_SUCCESS, false};
+    bool success = resolver.Resolve(p);
+    switch (order.type) {
+      case ORDER_MOVE:
+        moved[p] = success;
+        if (success) {
+          dislodgedBy[order.to.province] = p;
+        } else {
+          resolved.result = resolver.PathOk(p) ? RESULT_BOUNCE : RESULT_NO_CONVOY;
+        }
+        break;
+      case ORDER_SUPPORT:
+        resolved.result = !resolver.Valid(p) ? RESULT_VOID : success ? RESULT_SUCCESS : RESULT_CUT;
+        break;
+      case ORDER_CONVOY:
+        resolved.result = !resolver.Valid(p) ? RESULT_VOID
+                                             : success ? RESULT_SUCCESS : RESULT_DISRUPTED;
+        break;
+      default:
+        break;
+    }
+    result->orders.push_back(resolved);
+  }
+
+  // Move the units, lifting out the dislodged ones
+  std::vector<Unit> units(count, Unit{-1, UNIT_ARMY, COAST_NONE});
+  std::vector<ProvinceId> dislodged;
+  for (ProvinceId p = 0; p < count; ++p) {
+    const Unit& unit = board->units[p];
+    if (unit.power < 0) {
+      continue;
+    }
+    if (moved[p]) {
+      const Location& to = resolver.OrderAt(p).to;
+      units[to.province] = Unit{unit.power, unit.type, to.coast};
+    } else if (dislodgedBy[p] != NO_PROVINCE) {
+      dislodged.push_back(p);
+    }
+  }
+  for (ProvinceId p = 0; p < count; ++p) {
+    if (board->units[p].power >= 0 && !moved[p] && dislodgedBy[p] == NO_PROVINCE) {
+      units[p] = board->units[p];
+    }
+  }
+  for (auto& resolved : result->orders) {
+    resolved.dislodged = dislodgedBy[resolved.order.unit.province] != NO_PROVINCE &&
+                         !moved[resolved.order.unit.province];
+  }
+
+  // Provinces left empty by a standoff cannot be retreated to
+  std::vector<bool> contested(count, false);
+  for (ProvinceId p = 0; p < count; ++p) {
+    if (units[p].power >= 0 || dislodgedBy[p] != NO_PROVINCE) {
+      continue;
+    }
+    for (ProvinceId mover : resolver.MovesTo(p)) {
+      if (resolver.PathOk(mover)) {
+        contested[p] = true;
+      }
+    }
+  }
+
+  board->dislodged.clear();
+  for (ProvinceId p : dislodged) {
+    const Unit& unit = board->units[p];
+    DislodgedUnit entry = {unit.power, unit.type, Location{p, unit.coast}, {}};
+    ProvinceId attacker = dislodgedBy[p];
+    bool convoyed = resolver.OrderAt(attacker).viaConvoy;
+    for (const Location& next : map.Neighbours(unit.type, entry.location)) {
+      if (units[next.province].power < 0 && !contested[next.province] &&
+          (convoyed || next.province != attacker)) {
+        entry.retreats.push_back(next);
+      }
+    }
+    board->dislodged.push_back(entry);
+  }
+
+  board->units.swap(units);
+  result->dislodged = board->dislodged;
+}
+
+void adjudicateRetreats(Board* board, const std::vector<Order>& orders, PhaseResult* result) {
+  int count = board->GetMap().ProvinceCount();
+  std::vector<ResolvedOrder> retreats;
+  for (const DislodgedUnit& unit : board->dislodged) {
+    Order order = {ORDER_DISBAND, unit.power, unit.type, unit.location,
+                   NO_PROVINCE, Location{NO_PROVINCE, COAST_NONE}, false};
+    for (const Order& given : orders) {
+      if ((given.type == ORDER_RETREAT || given.type == ORDER_DISBAND) &&
+          given.unit == unit.location && given.power == unit.power) {
+        order = given;
+      }
+    }
+    retreats.push_back({order, RESULT_SUCCESS, false});
+  }
+
+  // Units retreating to the same place are all disbanded
+  std::vector<int> arrivals(count, 0);
+  for (const auto& retreat : retreats) {
+    if (retreat.order.type == ORDER_RETREAT) {
+      arrivals[retreat.order.to.province]++;
+    }
+  }
+  for (auto& retreat : retreats) {
+    const Order& order = retreat.order;
+    if (order.type == ORDER_RETREAT && arrivals[order.to.province] == 1) {
+      board->units[order.to.province] =
+          Unit{static_cast<int8_t>(order.power), order.unitType, order.to.coast};
+    } else {
+      retreat.result = order.type == ORDER_RETREAT ? RESULT_BOUNCE : RESULT_DISBANDED;
+    }
+  }
+
+  board->dislodged.clear();
+  result->orders = retreats;
+}
+
+// Moves from each province to the nearest home center of `power`, by any
+// unit over any border
+std::vector<int> homeDistances(const Map& map, int power) {
+  int count = map.ProvinceCount();
+  std::vector<int> distance(count, -1);
+  std::deque<ProvinceId> queue;
+  for (ProvinceId p = 0; p < count; ++p) {
+    if (map.GetProvince(p).homePower == power) {
+      distance[p] = 0;
+      queue.push_back(p);
+    }
+  }
+  while (!queue.empty()) {
+    ProvinceId p = queue.front();
+    queue.pop_front();
+    std::vector<Location> next = map.Neighbours(UNIT_ARMY, Location{p, COAST_NONE});
+    const Province& province = map.GetProvince(p);
+    if (province.type != PROVINCE_LAND) {
+      std::vector<Coast> coasts = province.coasts;
+      if (coasts.empty()) {
+        coasts.push_back(COAST_NONE);
+      }
+      for (Coast coast : coasts) {
+        const auto& fleet = map.Neighbours(UNIT_FLEET, Location{p, coast});
+        next.insert(next.end(), fleet.begin(), fleet.end());
+      }
+    }
+    for (const Location& location : next) {
+      if (distance[location.province] < 0) {
+        distance[location.province] = distance[p] + 1;
+        queue.push_back(location.province);
+      }
+    }
+  }
+  return distance;
+}
+
+void adjudicateAdjustments(Board* board, const std::vector<Order>& orders, PhaseResult* result) {
+  const Map& map = board->GetMap();
+  for (int power = 0; power < map.PowerCount(); ++power) {
+    int due = board->AdjustmentCount(power);
+    if (due > 0) {
+      for (const Order& order : orders) {
+        if (due == 0 || order.power != power) {
+          continue;
+        }
+        if (order.type == ORDER_WAIVE) {
+          due--;
+          result->orders.push_back({order, RESULT_SUCCESS, false});
+        } else if (order.type == ORDER_BUILD && !board->Occupied(order.unit.province)) {
+          due--;
+          board->units[order.unit.province] =
+              Unit{static_cast<int8_t>(power), order.unitType, order.unit.coast};
+          result->orders.push_back({order, RESULT_SUCCESS, false});
+        }
+      }
+    } else if (due < 0) {
+      for (const Order& order : orders) {
+        if (due == 0 || order.power != power || order.type != ORDER_REMOVE ||
+            board->units[order.unit.province].power != power) {
+          continue;
+        }
+        due++;
+        board->units[order.unit.province].power = -1;
+        result->orders.push_back({order, RESULT_SUCCESS, false});
+      }
+
+      // Civil disorder: furthest from home first, fleets before armies,
+      // then alphabetically
+      if (due < 0) {
+        std::vector<int> distance = homeDistances(map, power);
+        std::vector<ProvinceId> candidates;
+        for (ProvinceId p = 0; p < map.ProvinceCount(); ++p) {
+          if (board->units[p].power == power) {
+            candidates.push_back(p);
+          }
+        }
+        std::sort(candidates.begin(), candidates.end(), [&](ProvinceId a, ProvinceId b) {
+          if (distance[a] != distance[b]) {
+            return distance[a] > distance[b];
+          }
+          if (board->units[a].type != board->units[b].type) {
+            return board->units[a].type == UNIT_FLEET;
+          }
+          return a < b;
+        });
+        for (size_t i = 0; due < 0 && i < candidates.size(); ++i, ++due) {
+          ProvinceId p = candidates[i];
+          const Unit& unit = board->units[p];
+          Order order = {ORDER_REMOVE, power, unit.type, Location{p, unit.coast},
+                         NO_PROVINCE, Location{NO_PROVINCE, COAST_NONE}, false};
+          result->orders.push_back({order, RESULT_DISBANDED, false});
+          board->units[p].power = -1;
+        }
+      }
+    }
+  }
+}
+
+// Whether any power has builds it can make or removals it must make
+template <class Rules>
+bool adjustmentsDue(const Board& board) {
+  const Map& map = board.GetMap();
+  for (int power = 0; power < map.PowerCount(); ++power) {
+    int due = board.AdjustmentCount(power);
+    if (due < 0) {
+      return true;
+    }
+    if (due == 0) {
+      continue;
+    }
+    for (ProvinceId p = 0; p < map.ProvinceCount(); ++p) {
+      if (canBuild<Rules>(board, power, p)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void updateOwnership(Board* board, PhaseResult* result) {
+  const Map& map = board->GetMap();
+  std::vector<int> deltas(map.PowerCount(), 0);
+  for (ProvinceId p = 0; p < map.ProvinceCount(); ++p) {
+    int8_t occupier = board->units[p].power;
+    if (!map.GetProvince(p).supplyCenter || occupier < 0 || occupier == board->owners[p]) {
+      continue;
+    }
+    if (board->owners[p] >= 0) {
+      deltas[board->owners[p]]--;
+    }
+    deltas[occupier]++;
+    board->owners[p] = occupier;
+  }
+  result->ownershipUpdated = true;
+  for (int power = 0; power < map.PowerCount(); ++power) {
+    if (deltas[power] != 0) {
+      result->centerDeltas.push_back({power, deltas[power]});
+    }
+  }
+}
+
+// Move on from a finished movement or retreat phase
+template <class Rules>
+void endSeason(Board* board, PhaseResult* result) {
+  if (board->season == SEASON_SPRING) {
+    board->season = SEASON_FALL;
+    board->phase = PHASE_MOVEMENT;
+    return;
+  }
+  updateOwnership(board, result);
+  if (adjustmentsDue<Rules>(*board)) {
+    board->season = SEASON_WINTER;
+    board->phase = PHASE_ADJUSTMENT;
+    return;
+  }
+  board->year++;
+  board->season = SEASON_SPRING;
+  board->phase = PHASE_MOVEMENT;
+}
+
+template <class Rules>
+bool parseOrder(const Board& board, int power, const std::string& text,
+                Order* order, std::string* error) {
+  OrderParser parser(board.GetMap(), text);
+  *order = Order{ORDER_HOLD, power, UNIT_ARMY, Location{NO_PROVINCE, COAST_NONE},
+                 NO_PROVINCE, Location{NO_PROVINCE, COAST_NONE}, false};
+  if (parser.AtEnd()) {
+    return fail(error, "Empty order");
+  }
+
+  // Optional "France:" prefix
+  if (parser.Lookahead(1) == ":") {
+    int named = board.GetMap().FindPower(parser.Peek());
+    if (named < 0) {
+      return fail(error, "Unknown power");
+    }
+    if (power >= 0 && named != power) {
+      return fail(error, "Order is for another power");
+    }
+    power = named;
+    order->power = named;
+    parser.Skip(2);
+  }
+
+  switch (board.phase) {
+    case PHASE_MOVEMENT:
+      return parseMovement(board, parser, power, order, error);
+    case PHASE_RETREAT:
+      return parseRetreat(board, parser, power, order, error);
+    default:
+      return parseAdjustment<Rules>(board, parser, power, order, error);
+  }
+}
+
+template <class Rules>
+void adjudicate(Board* board, const std::vector<Order>& orders, PhaseResult* result) {
+  result->year = board->year;
+  result->season = board->season;
+  result->phase = board->phase;
+  result->orders.clear();
+  result->dislodged.clear();
+  result->ownershipUpdated = false;
+  result->centerDeltas.clear();
+
+  switch (board->phase) {
+    case PHASE_MOVEMENT:
+      adjudicateMovement(board, orders, result);
+      if (!board->dislodged.empty()) {
+        board->phase = PHASE_RETREAT;
+      } else {
+        endSeason<Rules>(board, result);
+      }
+      break;
+    case PHASE_RETREAT:
+      adjudicateRetreats(board, orders, result);
+      endSeason<Rules>(board, result);
+      break;
+    case PHASE_ADJUSTMENT:
+      adjudicateAdjustments(board, orders, result);
+      board->year++;
+      board->season = SEASON_SPRING;
+      board->phase = PHASE_MOVEMENT;
+      break;
+  }
+
+  std::stable_sort(result->orders.begin(), result->orders.end(), reportOrder);
+}
+
+}  // namespace
+
+bool ParseOrder(const Board& board, int power, const std::string& text,
+                Order* order, std::string* error) {
+  return board.Rules().parseOrder(board, power, text, order, error);
+}
+
+std::string FormatOrder(const Map& map, const Order& order) {
+  std::string unit = order.unitType == UNIT_ARMY ? "A " : "F ";
+  switch (order.type) {
+    case ORDER_HOLD:
+      return unit + map.LocationName(order.unit) + " H";
+    case ORDER_MOVE:
+      return unit + map.LocationName(order.unit) + "-" + map.LocationName(order.to) +
+             (order.viaConvoy ? " VIA CONVOY" : "");
+    case ORDER_SUPPORT: {
+      std::string text = unit + map.LocationName(order.unit) + " S " +
+                         map.GetProvince(order.from).abbr;
+      if (order.to.province != order.from) {
+        text += "-" + map.GetProvince(order.to.province).abbr;
+      }
+      return text;
+    }
+    case ORDER_CONVOY:
+      return unit + map.LocationName(order.unit) + " C A " + map.GetProvince(order.from).abbr +
+             "-" + map.GetProvince(order.to.province).abbr;
+    case ORDER_RETREAT:
+      return unit + map.LocationName(order.unit) + " R " + map.LocationName(order.to);
+    case ORDER_DISBAND:
+      return unit + map.LocationName(order.unit) + " D";
+    case ORDER_BUILD:
+      return "BUILD " + unit + map.LocationName(order.unit);
+    case ORDER_REMOVE:
+      return "REMOVE " + unit + map.LocationName(order.unit);
+    case ORDER_WAIVE:
+      return "WAIVE";
+  }
+  return "";
+}
+
+void Adjudicate(Board* board, const std::vector<Order>& orders, PhaseResult* result) {
+  board->Rules().adjudicate(board, orders, result);
+}
+
+bool CanBuild(const Board& board, int power, ProvinceId province) {
+  return board.Rules().canBuild(board, power, province);
+}
+
+template <class Rules>
+const RuleSet& RulesFor() {
+  static const RuleSet rules = {Rules::kName, parseOrder<Rules>, adjudicate<Rules>,
+                                canBuild<Rules>};
+  return rules;
+}
+
+template const RuleSet& RulesFor<StandardRules>();
+template const RuleSet& RulesFor<BuildAnywhereRules>();
+template const RuleSet& RulesFor<ChaosRules>();
+
+}  // namespace diplomacy
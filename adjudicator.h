@@ -0,0 +1,165 @@
+#ifndef ADJUDICATOR_H
+#define ADJUDICATOR_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "dip_map.h"
+
+namespace diplomacy {
+
+enum Season : int8_t {
+  SEASON_SPRING = 0,
+  SEASON_FALL,
+  SEASON_WINTER
+};
+
+enum PhaseType : int8_t {
+  PHASE_MOVEMENT = 0,
+  PHASE_RETREAT,
+  PHASE_ADJUSTMENT
+};
+
+// The unit standing in a province; power is -1 when the province is empty
+struct Unit {
+  int8_t power;
+  UnitType type;
+  Coast coast;
+};
+
+// A unit dislodged in the last movement phase, with where it may retreat
+struct DislodgedUnit {
+  int power;
+  UnitType type;
+  Location location;
+  std::vector<Location> retreats;
+};
+
+struct RuleSet;
+
+// Position of one game between phases. Plain data, so checkpoints and
+// copies are cheap to take.
+class Board {
+ public:
+  // The starting position of `map`, Spring 1901 movement, played under the
+  // standard rules or those of `rules`
+  explicit Board(const Map& map);
+  Board(const Map& map, const RuleSet& rules);
+
+  const Map& GetMap() const { return *map_; }
+  const RuleSet& Rules() const { return *rules_; }
+
+  int year;
+  Season season;
+  PhaseType phase;
+  std::vector<Unit> units;            // Per province
+  std::vector<int8_t> owners;         // Per province, -1 if unowned
+  std::vector<DislodgedUnit> dislodged;
+
+  // "S1901M" style phase name
+  std::string PhaseName() const;
+
+  bool Occupied(ProvinceId province) const { return units[province].power >= 0; }
+  int UnitCount(int power) const;
+  int CenterCount(int power) const;
+
+  // Builds (positive) or removals (negative) due in the adjustment phase
+  int AdjustmentCount(int power) const;
+
+ private:
+  const Map* map_;
+  const RuleSet* rules_;
+};
+
+enum OrderType : int8_t {
+  ORDER_HOLD = 0,
+  ORDER_MOVE,
+  ORDER_SUPPORT,
+  ORDER_CONVOY,
+  ORDER_RETREAT,
+  ORDER_DISBAND,
+  ORDER_BUILD,
+  ORDER_REMOVE,
+  ORDER_WAIVE
+};
+
+// One order, checked against the board it was parsed on.
+//   Move/retreat: unit -> to
+//   Support: unit supports the unit in `from` to `to` (to == from to hold)
+//   Convoy: unit convoys the army in `from` to `to`
+//   Build/remove: a unit of unitType at `unit`
+struct Order {
+  OrderType type;
+  int power;
+  UnitType unitType;
+  Location unit;
+  ProvinceId from;
+  Location to;
+  bool viaConvoy;
+};
+
+// Parse one order in judge syntax ("A PAR-BUR", "F NTH C A LON-NWY",
+// "BUILD A PAR", ...) for `power` against `board`. A leading "France:" is
+// accepted; power -1 takes the owner of the ordered unit. Returns false and
+// sets `error` if the order is malformed or illegal in this phase.
+bool ParseOrder(const Board& board, int power, const std::string& text,
+                Order* order, std::string* error);
+
+// Judge syntax for an order, as ParseOrder reads it back ("A PAR-BUR",
+// "F STP/SC R BOT", "BUILD A PAR")
+std::string FormatOrder(const Map& map, const Order& order);
+
+enum OrderResult : int8_t {
+  RESULT_SUCCESS = 0,
+  RESULT_BOUNCE,       // Move or retreat failed
+  RESULT_CUT,          // Support cut
+  RESULT_VOID,         // Support or convoy not matched by the other unit
+  RESULT_NO_CONVOY,    // Convoyed move without a convoy path
+  RESULT_DISRUPTED,    // Convoy fleet dislodged
+  RESULT_DISBANDED     // Retreat failed, or the unit was disbanded
+};
+
+struct ResolvedOrder {
+  Order order;
+  OrderResult result;
+  bool dislodged;      // Movement only: the ordering unit was dislodged
+};
+
+// What happened in one adjudicated phase
+struct PhaseResult {
+  int year;
+  Season season;
+  PhaseType phase;
+  std::vector<ResolvedOrder> orders;       // Orders as resolved, in board order
+  std::vector<DislodgedUnit> dislodged;    // Units that must now retreat
+  bool ownershipUpdated;                   // Supply centers changed hands this phase
+  std::vector<std::pair<int, int>> centerDeltas;  // (power, change) after ownership
+};
+
+// Adjudicate the current phase of `board` and advance it to the next phase
+// that needs orders. Units without a valid order hold, dislodged units
+// without a retreat disband and missing removals are taken in civil disorder.
+void Adjudicate(Board* board, const std::vector<Order>& orders, PhaseResult* result);
+
+// Whether `power` may build in `province` now: an owned, empty supply
+// center its rules allow building in
+bool CanBuild(const Board& board, int power, ProvinceId province);
+
+// The adjudicator instantiated for one rule policy (rules.h). A board
+// dispatches through its rule set once per call; inside, the policy's
+// rules are compile-time constants.
+struct RuleSet {
+  const char* name;
+  bool (*parseOrder)(const Board&, int, const std::string&, Order*, std::string*);
+  void (*adjudicate)(Board*, const std::vector<Order>&, PhaseResult*);
+  bool (*canBuild)(const Board&, int, ProvinceId);
+};
+
+// Instantiated for StandardRules, BuildAnywhereRules and ChaosRules
+template <class Rules>
+const RuleSet& RulesFor();
+
+}  // namespace diplomacy
+
+#endif // ADJUDICATOR_H
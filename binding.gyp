@@ -3,7 +3,27 @@
     {
       "target_name": "dip_binding",
       "sources": [
-        "dip_binding.cpp"
+        "adjudication_queue.cpp",
+        "adjudicator.cpp",
+        "dip_binding.cpp",
+        "dip_map.cpp",
+        "game_control.cpp",
+        "game_end.cpp",
+        "game_history.cpp",
+        "id_generator.cpp",
+        "map_renderer.cpp",
+        "move_search.cpp",
+        "napi_util.cpp",
+        "observers.cpp",
+        "order_store.cpp",
+        "press_policy.cpp",
+        "press_store.cpp",
+        "profile_store.cpp",
+        "report.cpp",
+        "variant.cpp"
+      ],
+      "defines": [
+        "NAPI_VERSION=6"
       ],
       "include_dirs": [
         "..",
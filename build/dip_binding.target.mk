@@ -4,6 +4,7 @@ TOOLSET := target
 TARGET := dip_binding
 DEFS_Debug := \
 	'-DNODE_GYP_MODULE_NAME=dip_binding' \
+	'-DNAPI_VERSION=6' \
 	'-DUSING_UV_SHARED=1' \
 	'-DUSING_V8_SHARED=1' \
 	'-DV8_DEPRECATION_WARNINGS=1' \
@@ -53,6 +54,7 @@ INCS_Debug := \
 
 DEFS_Release := \
 	'-DNODE_GYP_MODULE_NAME=dip_binding' \
+	'-DNAPI_VERSION=6' \
 	'-DUSING_UV_SHARED=1' \
 	'-DUSING_V8_SHARED=1' \
 	'-DV8_DEPRECATION_WARNINGS=1' \
@@ -99,7 +101,24 @@ INCS_Release := \
 	-I$(srcdir)/.
 
 OBJS := \
-	$(obj).target/$(TARGET)/dip_binding.o
+	$(obj).target/$(TARGET)/adjudication_queue.o \
+	$(obj).target/$(TARGET)/adjudicator.o \
+	$(obj).target/$(TARGET)/dip_binding.o \
+	$(obj).target/$(TARGET)/dip_map.o \
+	$(obj).target/$(TARGET)/game_control.o \
+	$(obj).target/$(TARGET)/game_end.o \
+	$(obj).target/$(TARGET)/game_history.o \
+	$(obj).target/$(TARGET)/id_generator.o \
+	$(obj).target/$(TARGET)/map_renderer.o \
+	$(obj).target/$(TARGET)/move_search.o \
+	$(obj).target/$(TARGET)/napi_util.o \
+	$(obj).target/$(TARGET)/observers.o \
+	$(obj).target/$(TARGET)/order_store.o \
+	$(obj).target/$(TARGET)/press_policy.o \
+	$(obj).target/$(TARGET)/press_store.o \
+	$(obj).target/$(TARGET)/profile_store.o \
+	$(obj).target/$(TARGET)/report.o \
+	$(obj).target/$(TARGET)/variant.o
 
 # Add to the list of files we specially track dependencies for.
 all_deps += $(OBJS)
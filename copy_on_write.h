@@ -0,0 +1,40 @@
+#ifndef COPY_ON_WRITE_H
+#define COPY_ON_WRITE_H
+
+#include <memory>
+#include <utility>
+
+namespace diplomacy {
+
+// A value shared read-only with others until it is first written, then
+// copied into storage of its own. Holding the shared value costs a
+// reference count, so many holders of one template are cheap.
+template <class T>
+class CopyOnWrite {
+ public:
+  explicit CopyOnWrite(std::shared_ptr<const T> shared) : shared_(std::move(shared)) {}
+
+  CopyOnWrite(CopyOnWrite&&) = default;
+  CopyOnWrite& operator=(CopyOnWrite&&) = default;
+
+  const T& Get() const { return owned_ ? *owned_ : *shared_; }
+
+  // The value for writing, copied out of the shared one on first use
+  T& Mutable() {
+    if (!owned_) {
+      owned_.reset(new T(*shared_));
+      shared_.reset();
+    }
+    return *owned_;
+  }
+
+  bool IsShared() const { return !owned_; }
+
+ private:
+  std::shared_ptr<const T> shared_;
+  std::unique_ptr<T> owned_;
+};
+
+}  // namespace diplomacy
+
+#endif // COPY_ON_WRITE_H
@@ -1,10 +1,34 @@
-#include <node.h>
+#include <algorithm>
+#include <chrono>
 #include <string>
 #include <vector>
 #include <map>
-#include <random>
+#include <set>
+#include <memory>
+#include <limits>
+#include <sstream>
+#include <thread>
 #include <iostream>
+#include <cctype>
+#include <cstdlib>
 #include "dip_binding.h"
+#include "adjudication_queue.h"
+#include "adjudicator.h"
+#include "copy_on_write.h"
+#include "game_control.h"
+#include "game_end.h"
+#include "game_history.h"
+#include "id_generator.h"
+#include "map_renderer.h"
+#include "move_search.h"
+#include "napi_util.h"
+#include "observers.h"
+#include "order_store.h"
+#include "press_policy.h"
+#include "press_store.h"
+#include "profile_store.h"
+#include "report.h"
+#include "variant.h"
 
 namespace diplomacy {
 
@@ -28,6 +52,7 @@ struct GameDetails {
   std::string victoryConditions;
   std::string startTime;
   std::vector<Player> players;
+  int playerCount = 7;  // Seats, at most one per power of the variant
 };
 
 // Email struct
@@ -36,93 +61,876 @@ struct Email {
   std::string from;
   std::string subject;
   std::string body;
+  std::shared_ptr<const std::string> report; // Result text shared by every recipient, sent after body
 };
 
-// Player preference struct
-struct PlayerPreference {
-  bool notifications;
-  bool deadlineReminders;
-  bool orderConfirmation;
+// A game as it stood when backed up: enough to put it back however far
+// it has since been played, or rolled back by another backup
+struct GameBackup {
+  std::string gameId;
+  const Variant* variant;
+  std::shared_ptr<const Board> board;
+  GameHistory history;
+  GameEndTracker tracker;
 };
 
-// Game state
-std::string currentPhase = "DIPLOMACY";
-std::string currentSeason = "SPRING";
-int currentYear = 1901;
-std::vector<Player> players;
+// Everything one JavaScript environment knows. The main thread and each
+// worker thread that loads the addon get an Engine of their own, kept as
+// the environment's Node-API instance data.
+// Only that thread touches it, so its members need no locks of their own;
+// OrderStore keeps lock-free slots because it promises them to any caller.
+struct Engine {
+  // Game state
+  std::string currentPhase = "DIPLOMACY";
+  std::string currentSeason = "SPRING";
+  int currentYear = 1901;
+  std::vector<Player> players;
+
+  // Map of player IDs to email addresses
+  std::map<int, std::string> playerEmails;
+  std::map<int, std::string> playerGames; // Player ID to the game they joined
 
-// Map of player IDs to email addresses
-std::map<int, std::string> playerEmails;
+  // Game storage
+  std::map<std::string, GameDetails> games;
+  std::map<std::string, PressPolicy> pressPolicies; // Game ID to compiled press rules
+  std::map<std::string, PressStore> pressStores; // Game ID to press log
+  std::map<std::string, GameEndTracker> gameEnds; // Game ID to draw votes and victory state
+  std::map<std::string, CopyOnWrite<Board>> boards; // Game ID to the current position, shared with the variant's start until adjudicated
+  std::map<std::string, const Variant*> gameVariants; // Game ID to the variant it is played under
+  std::map<std::string, ReportWriter> reportWriters; // Game ID to its result renderer
+  std::map<std::string, MapRenderer> mapRenderers; // Game ID to its map renderer
+  std::map<std::string, std::shared_ptr<const std::string>> latestReports; // Game ID to last results
+  std::map<std::string, GameHistory> histories; // Game ID to adjudicated orders and checkpoints
+  std::map<std::string, GameBackup> backups; // Backup ID to the game as it was
+  std::map<std::string, OrderStore> orderStores; // Game ID to orders submitted for the current phase
+  std::map<std::string, ReadinessTracker> readiness; // Game ID to which powers are ready for adjudication
+  std::map<std::string, int> minimumWaits; // Game ID to minutes a phase runs before it may end early
+  AdjudicationQueue adjudicationQueue; // Games ready to adjudicate ahead of their deadline
+  std::map<std::string, std::map<int, int>> botPlayers; // Game ID to bot-played powers and their time budget in ms
+  std::map<std::string, ObserverRegistry> observers; // Game ID to its watchers and the views some have still to get
+  std::map<std::string, GameControl> gameControls; // Game ID to its master, pause and access settings, and their journal
+  uint64_t controlBatches = 0; // Master command batches applied so far
 
-// Game storage
-std::map<std::string, GameDetails> games;
-std::map<std::string, std::string> pressRules; // Game ID to press rules mapping
+  // Player data storage
+  std::map<std::string, std::string> emailMap; // Maps new emails to existing ones
+  ProfileStore profiles; // Player ID to preferences, vacation, level and address; in memory until openProfileStore
+  std::vector<Email> outboundEmails; // Store emails for testing
+};
 
-// Player data storage
-std::map<std::string, std::string> emailMap; // Maps new emails to existing ones
-std::map<int, PlayerPreference> playerPreferences; // Player ID to preferences
-std::vector<Email> outboundEmails; // Store emails for testing
+// The engine of the environment whose call is running on this thread;
+// every export sets it on entry
+thread_local Engine* engine = nullptr;
 
 // Utilities for generating IDs
-std::string generateId(int length = 8) {
-  static const char alphanum[] =
-    "0123456789"
-    "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
-    "abcdefghijklmnopqrstuvwxyz";
+
+// A game ID not in use. IDs sort in creation order, so the game list only
+// ever grows at its end.
+std::string newGameId() {
+  std::string id;
+  do {
+    id = SortableToken(4);
+  } while (engine->games.count(id));
+  return id;
+}
+
+std::string newBackupId() {
+  std::string id;
+  do {
+    id = "backup-" + RandomToken(8);
+  } while (engine->backups.count(id));
+  return id;
+}
+
+// A player ID not yet issued; IDs below 100 are left for special meanings
+// such as 0 for "no player"
+int newPlayerId() {
+  int id;
+  do {
+    id = static_cast<int>(RandomInRange(100, std::numeric_limits<int32_t>::max()));
+  } while (engine->playerEmails.count(id));
+  return id;
+}
+
+// Press and mailbox keys use upper-case power names
+std::string upperCase(const std::string& text) {
+  std::string result = text;
+  for (auto& c : result) {
+    c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+  }
+  return result;
+}
+
+// Find the power played by a registered player, or "" if unknown
+std::string playerPower(int playerId) {
+  for (const auto& player : engine->players) {
+    if (player.status == playerId) {
+      return upperCase(player.power);
+    }
+  }
+  return "";
+}
+
+// The player who mails from `email`, following linked addresses; 0 if none
+int emailPlayerId(const std::string& email) {
+  auto linked = engine->emailMap.find(email);
+  const std::string& address = linked != engine->emailMap.end() ? linked->second : email;
+  for (const auto& pair : engine->playerEmails) {
+    if (pair.second == address) {
+      return pair.first;
+    }
+  }
+  return 0;
+}
+
+// A player's profile, or an empty one if they have not set anything yet
+PlayerProfile playerProfile(int playerId) {
+  PlayerProfile profile;
+  if (!engine->profiles.Get(playerId, &profile)) {
+    profile.playerId = playerId;
+  }
+  return profile;
+}
+
+// Milliseconds since the epoch at midnight UTC of a YYYY-MM-DD date
+bool parseDate(const std::string& text, int64_t* ms) {
+  int year, month, day;
+  char dash1, dash2;
+  std::istringstream in(text);
+  if (!(in >> year >> dash1 >> month >> dash2 >> day) || dash1 != '-' || dash2 != '-' ||
+      month < 1 || month > 12 || day < 1 || day > 31 || !in.eof()) {
+    return false;
+  }
+  // Days from civil date, counting years from March so leap days come last
+  int y = year - (month <= 2);
+  int era = (y >= 0 ? y : y - 399) / 400;
+  int yearOfEra = y - era * 400;
+  int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+  int64_t days = static_cast<int64_t>(era) * 146097 + dayOfEra - 719468;
+  *ms = days * 86400000;
+  return true;
+}
+
+// Find the registered player for a power, or -1 if nobody plays it
+int powerPlayerId(const std::string& power) {
+  for (const auto& player : engine->players) {
+    if (upperCase(player.power) == power && engine->playerEmails.count(player.status)) {
+      return player.status;
+    }
+  }
+  return -1;
+}
+
+// Players registered to a game
+std::vector<const Player*> gamePlayers(const std::string& gameId) {
+  std::vector<const Player*> result;
+  for (const auto& player : engine->players) {
+    auto it = engine->playerGames.find(player.status);
+    if (it != engine->playerGames.end() && it->second == gameId) {
+      result.push_back(&player);
+    }
+  }
+  return result;
+}
+
+// Press policy for a game, white press until the game sets its own
+PressPolicy gamePressPolicy(const std::string& gameId) {
+  auto it = engine->pressPolicies.find(gameId);
+  if (it != engine->pressPolicies.end()) {
+    return it->second;
+  }
+  PressPolicy policy = 0;
+  CompilePressRules("white", &policy);
+  return policy;
+}
+
+// The variant a game is played under, standard unless set
+const Variant& gameVariant(const std::string& gameId) {
+  auto it = engine->gameVariants.find(gameId);
+  return it != engine->gameVariants.end() ? *it->second : Variants().front();
+}
+
+CopyOnWrite<Board>& boardSlot(const std::string& gameId) {
+  auto it = engine->boards.find(gameId);
+  if (it == engine->boards.end()) {
+    it = engine->boards.emplace(gameId, CopyOnWrite<Board>(gameVariant(gameId).start)).first;
+  }
+  return it->second;
+}
+
+// Whether anything has created or played the game yet
+bool knownGame(const std::string& gameId) {
+  return engine->games.count(gameId) || engine->boards.count(gameId);
+}
+
+// Current position of a game, starting from its variant's setup
+const Board& gameBoard(const std::string& gameId) {
+  return boardSlot(gameId).Get();
+}
+
+// The position for adjudicating into; the first write copies the game's
+// board out of the shared start
+Board& writableBoard(const std::string& gameId) {
+  return boardSlot(gameId).Mutable();
+}
+
+// Settings a new game of a variant starts with, built once per variant
+const GameDetails& gameTemplate(const Variant& variant) {
+  static const std::map<std::string, GameDetails> templates = [] {
+    std::map<std::string, GameDetails> built;
+    for (const Variant& v : Variants()) {
+      built[v.name] = {"", "", "Description", v.name, "DIPLOMACY", "grey", 24, 12,
+                       "Standard", "2023-01-01", {}, v.map->PowerCount()};
+    }
+    return built;
+  }();
+  return templates.at(variant.name);
+}
+
+// Draw votes and victory state of a game. Every power of its map is
+// tracked from the start, in map order so that slots match power indices,
+// whether or not a player has taken its seat.
+GameEndTracker& gameEnd(const std::string& gameId) {
+  auto it = engine->gameEnds.find(gameId);
+  if (it == engine->gameEnds.end()) {
+    it = engine->gameEnds.emplace(gameId, GameEndTracker()).first;
+    const Board& board = gameBoard(gameId);
+    const Map& map = board.GetMap();
+    for (int p = 0; p < map.PowerCount(); ++p) {
+      it->second.AddPower(map.PowerKey(p), board.CenterCount(p));
+    }
+  }
+  return it->second;
+}
+
+// Orders submitted to a game, one slot per power of its map
+OrderStore& gameOrders(const std::string& gameId) {
+  auto it = engine->orderStores.find(gameId);
+  if (it == engine->orderStores.end()) {
+    it = engine->orderStores.emplace(gameId, OrderStore(gameBoard(gameId).GetMap().PowerCount())).first;
+  }
+  return it->second;
+}
+
+// The power a player holds in a game, or -1 if they have no seat in it
+int seatPower(const std::string& gameId, int playerId) {
+  auto game = engine->playerGames.find(playerId);
+  if (game == engine->playerGames.end() || game->second != gameId) {
+    return -1;
+  }
+  return gameBoard(gameId).GetMap().FindPower(playerPower(playerId));
+}
+
+// Store orders for `power` by the power of each unit ordered; with power
+// -1 (game master use) each order is taken for whoever owns the unit.
+// Lines that do not parse are returned with the reason.
+void storeOrders(const std::string& gameId, int power, const std::vector<std::string>& lines,
+                 std::vector<std::pair<std::string, std::string>>* rejected) {
+  const Board& board = gameBoard(gameId);
+  const Map& map = board.GetMap();
+  std::vector<std::vector<Order>> byPower(map.PowerCount());
+  for (const auto& line : lines) {
+    if (line.find_first_not_of(" \t\r") == std::string::npos) {
+      continue;
+    }
+    Order order;
+    std::string error;
+    if (ParseOrder(board, power, line, &order, &error)) {
+      byPower[order.power].push_back(order);
+    } else if (rejected) {
+      rejected->emplace_back(line, error);
+    }
+  }
+  std::string phase = board.PhaseName();
+  for (int p = 0; p < map.PowerCount(); ++p) {
+    if (!byPower[p].empty()) {
+      gameOrders(gameId).Submit(p, phase, byPower[p]);
+    }
+  }
+}
+
+const char* seasonName(Season season) {
+  static const char* const names[] = {"Spring", "Fall", "Winter"};
+  return names[season];
+}
+
+const char* phaseTypeName(PhaseType phase) {
+  static const char* const names[] = {"Movement", "Retreat", "Build"};
+  return names[phase];
+}
+
+// Bring the globals, registered players and end-of-game tracker in line
+// with a game's board after it has changed; `centerDeltas` are the
+// (power, change) pairs of the adjudication that changed it
+void syncGame(const std::string& gameId, const std::vector<std::pair<int, int>>& centerDeltas,
+              bool yearEnded) {
+  const Board& board = gameBoard(gameId);
+  const Map& map = board.GetMap();
+  engine->currentSeason = seasonName(board.season);
+  engine->currentPhase = phaseTypeName(board.phase);
+  engine->currentYear = board.year;
+  
+  // Registered players follow their power on the board
+  for (auto& player : engine->players) {
+    auto it = engine->playerGames.find(player.status);
+    int power = map.FindPower(player.power);
+    if (it != engine->playerGames.end() && it->second == gameId && power >= 0) {
+      player.units = board.UnitCount(power);
+      player.centers = board.CenterCount(power);
+    }
+  }
   
-  std::random_device rd;
-  std::mt19937 gen(rd());
-  std::uniform_int_distribution<> dis(0, sizeof(alphanum) - 2);
+  // Tracker slots are power indices, so the deltas apply as they are
+  GameEndTracker& tracker = gameEnd(gameId);
+  tracker.ApplyCenterDeltas(centerDeltas);
+  if (yearEnded) {
+    tracker.EndOfYear(engine->currentYear - 1);
+  }
+}
+
+int64_t nowMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// Units of `power` that need an order this phase; returns how many
+// orders are due, which in an adjustment phase is the builds (as far as
+// there are sites) or removals owed rather than a unit each
+int ordersDue(const Board& board, int power, std::vector<ProvinceId>* units) {
+  const Map& map = board.GetMap();
+  switch (board.phase) {
+    case PHASE_MOVEMENT:
+      for (ProvinceId p = 0; p < map.ProvinceCount(); ++p) {
+        if (board.units[p].power == power) {
+          units->push_back(p);
+        }
+      }
+      break;
+    case PHASE_RETREAT:
+      for (const DislodgedUnit& unit : board.dislodged) {
+        if (unit.power == power) {
+          units->push_back(unit.location.province);
+        }
+      }
+      break;
+    case PHASE_ADJUSTMENT: {
+      int due = board.AdjustmentCount(power);
+      if (due <= 0) {
+        return -due;
+      }
+      int sites = 0;
+      for (ProvinceId p = 0; p < map.ProvinceCount() && sites < due; ++p) {
+        sites += CanBuild(board, power, p);
+      }
+      return sites;
+    }
+  }
+  return static_cast<int>(units->size());
+}
+
+// Whether a power's submission gives an order to everything that needs one
+bool ordersComplete(const Board& board, int power, const Submission* submission) {
+  std::vector<ProvinceId> units;
+  int due = ordersDue(board, power, &units);
+  if (due == 0) {
+    return true;
+  }
+  if (!submission) {
+    return false;
+  }
+  if (board.phase == PHASE_ADJUSTMENT) {
+    return submission->orders.size() >= static_cast<size_t>(due);
+  }
+  for (ProvinceId province : units) {
+    bool ordered = std::any_of(submission->orders.begin(), submission->orders.end(),
+                               [province](const Order& order) { return order.unit.province == province; });
+    if (!ordered) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Mark the powers a game waits for, and whether each has complete orders:
+// every power with a player, unless played by the bot or with nothing to
+// order
+void seatReadiness(const std::string& gameId, ReadinessTracker* tracker) {
+  const Board& board = gameBoard(gameId);
+  const Map& map = board.GetMap();
+  auto bots = engine->botPlayers.find(gameId);
+  std::vector<bool> seated(map.PowerCount(), false);
+  for (const Player* player : gamePlayers(gameId)) {
+    int power = map.FindPower(player->power);
+    if (power >= 0) {
+      seated[power] = true;
+    }
+  }
+  for (int power = 0; power < map.PowerCount(); ++power) {
+    std::vector<ProvinceId> units;
+    bool active = seated[power] && !(bots != engine->botPlayers.end() && bots->second.count(power)) &&
+                  ordersDue(board, power, &units) > 0;
+    auto submission = active ? gameOrders(gameId).Latest(power, board.PhaseName()) : nullptr;
+    tracker->SetActive(power, active);
+    tracker->SetComplete(power, active && ordersComplete(board, power, submission.get()));
+  }
+}
+
+// Readiness of a game's powers, restarted whenever the game's phase moves on
+ReadinessTracker& gameReadiness(const std::string& gameId) {
+  const Board& board = gameBoard(gameId);
+  auto it = engine->readiness.find(gameId);
+  if (it == engine->readiness.end()) {
+    it = engine->readiness.emplace(gameId, ReadinessTracker(board.GetMap().PowerCount())).first;
+  }
+  if (it->second.Phase() != board.PhaseName()) {
+    it->second.StartPhase(board.PhaseName(), nowMs());
+    seatReadiness(gameId, &it->second);
+  }
+  return it->second;
+}
+
+bool gamePaused(const std::string& gameId) {
+  auto control = engine->gameControls.find(gameId);
+  return control != engine->gameControls.end() && control->second.paused;
+}
+
+// Queue a game for adjudication once every power it waits for is ready
+// and the minimum wait is over, or take it out of the queue
+void scheduleIfReady(const std::string& gameId, const ReadinessTracker& tracker) {
+  if (gamePaused(gameId) || !tracker.AllReady()) {
+    engine->adjudicationQueue.Cancel(gameId);
+    return;
+  }
+  auto wait = engine->minimumWaits.find(gameId);
+  int64_t waitMs = wait != engine->minimumWaits.end() ? int64_t(wait->second) * 60 * 1000 : 0;
+  engine->adjudicationQueue.Schedule(gameId, tracker.PhaseStart() + waitMs);
+}
+
+// Look again at every power of a game, after a change to who plays it or
+// to its settings
+void checkReady(const std::string& gameId) {
+  ReadinessTracker& tracker = gameReadiness(gameId);
+  seatReadiness(gameId, &tracker);
+  scheduleIfReady(gameId, tracker);
+}
+
+// Look again at one power of a game, after it has submitted orders
+void checkReady(const std::string& gameId, int power) {
+  const Board& board = gameBoard(gameId);
+  ReadinessTracker& tracker = gameReadiness(gameId);
+  if (tracker.Active(power)) {
+    auto submission = gameOrders(gameId).Latest(power, board.PhaseName());
+    tracker.SetComplete(power, ordersComplete(board, power, submission.get()));
+  }
+  scheduleIfReady(gameId, tracker);
+}
+
+bool hasObservers(const std::string& gameId) {
+  auto it = engine->observers.find(gameId);
+  return it != engine->observers.end() && it->second.Count() > 0;
+}
+
+// Publish a public view of a game and mail it to the watchers it is
+// released to; every mail shares the one rendered view
+void publishView(const std::string& gameId, const std::string& phase,
+                 const std::string& subject, std::shared_ptr<const std::string> body) {
+  if (!hasObservers(gameId)) {
+    return;
+  }
+  for (const ViewDelivery& delivery : engine->observers[gameId].Publish(phase, subject, std::move(body))) {
+    for (const std::string& address : *delivery.addresses) {
+      Email email;
+      email.to = address;
+      email.from = "system@diplomacy.net";
+      email.subject = delivery.view->subject;
+      email.report = delivery.view->body;
+      engine->outboundEmails.push_back(email);
+    }
+  }
+}
+
+// Adjudicate a game's current phase with every order submitted for it and
+// mail the results to its players; returns the number of orders resolved,
+// or -1 for a paused game, which is left alone until resumed
+int adjudicateGame(const std::string& gameId) {
+  if (gamePaused(gameId)) {
+    return -1;
+  }
+  Board& board = writableBoard(gameId);
+  std::vector<Order> orders = gameOrders(gameId).Collect(board.PhaseName());
+  
+  // Seats filled by the bot get searched orders in place of any sent for
+  // them. The searches run side by side and split the hardware threads, so
+  // the caller waits for the longest budget once, not for every bot in turn.
+  auto bots = engine->botPlayers.find(gameId);
+  if (bots != engine->botPlayers.end() && !bots->second.empty()) {
+    int hardware = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    int share = std::max(1, hardware / static_cast<int>(bots->second.size()));
+    std::vector<SearchResult> searches(bots->second.size());
+    std::vector<std::thread> workers;
+    size_t index = 0;
+    for (const auto& bot : bots->second) {
+      SearchOptions options;
+      options.timeBudgetMs = bot.second;
+      options.threads = share;
+      workers.emplace_back([&board, &searches, index, power = bot.first, options] {
+        searches[index] = SearchOrders(board, power, options);
+      });
+      ++index;
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+    index = 0;
+    for (const auto& bot : bots->second) {
+      orders.erase(std::remove_if(orders.begin(), orders.end(),
+                                  [&bot](const Order& order) { return order.power == bot.first; }),
+                   orders.end());
+      const SearchResult& search = searches[index++];
+      orders.insert(orders.end(), search.orders.begin(), search.orders.end());
+    }
+  }
   
-  std::string id;
-  for (int i = 0; i < length; ++i) {
-    id += alphanum[dis(gen)];
+  // Adjudicate the phase; units without valid orders hold
+  std::string phaseName = board.PhaseName();
+  engine->histories[gameId].Record(board, orders);
+  PhaseResult phaseResult;
+  Adjudicate(&board, orders, &phaseResult);
+  gameOrders(gameId).Clear();
+  engine->adjudicationQueue.Cancel(gameId);
+  gameReadiness(gameId);
+  syncGame(gameId, phaseResult.centerDeltas, board.year != phaseResult.year);
+  
+  // One report body for the game, shared by every player's results mail
+  auto report = std::make_shared<const std::string>(
+      engine->reportWriters[gameId].Write(board, phaseResult));
+  engine->latestReports[gameId] = report;
+  for (const Player* player : gamePlayers(gameId)) {
+    Email email;
+    email.to = engine->playerEmails[player->status];
+    email.from = "system@diplomacy.net";
+    email.subject = "Diplomacy results " + phaseName;
+    email.body = "Results for " + player->power + " in game " + gameId + "\n\n";
+    email.report = report;
+    engine->outboundEmails.push_back(email);
   }
   
-  return id;
+  // Watchers see the results and where every unit now stands
+  if (hasObservers(gameId)) {
+    auto view = std::make_shared<std::string>(*report);
+    view->push_back('\n');
+    view->append(engine->reportWriters[gameId].WritePositions(board));
+    publishView(gameId, phaseName, "Diplomacy results " + phaseName, std::move(view));
+  }
+  return static_cast<int>(orders.size());
+}
+
+// Master command batches
+
+struct MasterBatchError {
+  std::string gameId;
+  std::string command;
+  std::string error;
+};
+
+// Why a command cannot be applied to a game as the batch's earlier
+// commands leave it, or "" if it can. `paused` follows the batch along.
+std::string masterCommandError(const std::string& gameId, const MasterCommand& command, bool* paused) {
+  switch (command.action) {
+    case MASTER_PAUSE:
+      if (*paused) {
+        return "Game is already paused";
+      }
+      *paused = true;
+      break;
+    case MASTER_RESUME:
+      if (!*paused) {
+        return "Game is not paused";
+      }
+      *paused = false;
+      break;
+    case MASTER_PROCESS:
+      if (*paused) {
+        return "Game is paused";
+      }
+      break;
+    case MASTER_EJECT:
+      if (gameBoard(gameId).GetMap().FindPower(command.argument) < 0) {
+        return "No power " + command.argument + " in this game";
+      }
+      break;
+    default:
+      break;
+  }
+  return "";
+}
+
+// Free a power's seat in a game, dropping whoever held it
+void ejectPower(const std::string& gameId, int power) {
+  const Map& map = gameBoard(gameId).GetMap();
+  std::vector<Player> remaining;
+  for (const Player& player : engine->players) {
+    auto it = engine->playerGames.find(player.status);
+    if (it != engine->playerGames.end() && it->second == gameId &&
+        map.FindPower(player.power) == power) {
+      engine->playerGames.erase(it);
+    } else {
+      remaining.push_back(player);
+    }
+  }
+  engine->players.swap(remaining);
+}
+
+void applyMasterCommand(const std::string& gameId, const MasterCommand& command, GameControl* control) {
+  switch (command.action) {
+    case MASTER_SET_MASTER:
+      control->master = command.argument;
+      break;
+    case MASTER_PAUSE:
+      control->paused = true;
+      break;
+    case MASTER_RESUME:
+      control->paused = false;
+      break;
+    case MASTER_EXTEND:
+      control->extensionHours += command.values[0];
+      break;
+    case MASTER_PROCESS:
+      adjudicateGame(gameId);
+      break;
+    case MASTER_EJECT:
+      ejectPower(gameId, gameBoard(gameId).GetMap().FindPower(command.argument));
+      break;
+    case MASTER_PRESS:
+      engine->pressPolicies[gameId] = command.press;
+      break;
+    case MASTER_WAIT:
+      engine->minimumWaits[gameId] = command.values[0];
+      break;
+    case MASTER_VICTORY: {
+      GameEndTracker& tracker = gameEnd(gameId);
+      tracker.SetVictoryConditions(tracker.Dias(), command.values[0], tracker.MaxYear());
+      break;
+    }
+    case MASTER_MODERATE:
+    case MASTER_UNMODERATE:
+      control->moderated = command.action == MASTER_MODERATE;
+      break;
+    case MASTER_ACCESS:
+      control->access.dedication = command.values[0];
+      control->access.onTimeRating = command.values[1];
+      control->access.resistanceRating = command.values[2];
+      break;
+  }
+}
+
+// Apply `commands` to every game in `gameIds`, or to none of them: the
+// whole batch is checked against each game before any of it is applied.
+// A game journals the batch once, under a sequence number shared by every
+// game it touches. `master` must be each game's master when
+// `checkMaster` is set; it is "" for changes made through the settings
+// exports.
+bool applyMasterBatch(const std::string& master, const std::vector<std::string>& gameIds,
+                      const std::vector<MasterCommand>& commands, bool checkMaster,
+                      std::vector<MasterBatchError>* errors, uint64_t* sequence) {
+  // Each game is checked and journaled once, so it may be named only once
+  if (gameIds.empty()) {
+    errors->push_back({"", "", "No games given"});
+    return false;
+  }
+  std::set<std::string> named;
+  for (const auto& gameId : gameIds) {
+    if (!named.insert(gameId).second) {
+      errors->push_back({gameId, "", "Game named more than once"});
+    }
+  }
+  if (!errors->empty()) {
+    return false;
+  }
+
+  for (const auto& gameId : gameIds) {
+    auto it = engine->gameControls.find(gameId);
+    if (checkMaster && (master.empty() || it == engine->gameControls.end() ||
+                        it->second.master != master)) {
+      errors->push_back({gameId, "", "Not the master of this game"});
+      continue;
+    }
+    bool paused = it != engine->gameControls.end() && it->second.paused;
+    for (const auto& command : commands) {
+      std::string error = masterCommandError(gameId, command, &paused);
+      if (!error.empty()) {
+        errors->push_back({gameId, command.text, error});
+      }
+    }
+  }
+  if (!errors->empty()) {
+    return false;
+  }
+  if (commands.empty()) {
+    return true;
+  }
+
+  *sequence = ++engine->controlBatches;
+  std::vector<std::string> texts;
+  for (const auto& command : commands) {
+    texts.push_back(command.text);
+  }
+  for (const auto& gameId : gameIds) {
+    GameControl& control = engine->gameControls[gameId];
+    control.journal.push_back({*sequence, master, gameBoard(gameId).PhaseName(), texts});
+    for (const auto& command : commands) {
+      applyMasterCommand(gameId, command, &control);
+    }
+    checkReady(gameId);
+  }
+  return true;
 }
 
-// Use v8 namespace for cleaner code
-using v8::FunctionCallbackInfo;
-using v8::Value;
-using v8::Isolate;
-using v8::Local;
-using v8::Object;
-using v8::String;
-using v8::Number;
-using v8::Array;
-using v8::Boolean;
-using v8::Context;
-using v8::Exception;
+// Label used to stamp press with the phase it was sent in
+std::string phaseLabel() {
+  return engine->currentSeason + " " + std::to_string(engine->currentYear) + " " + engine->currentPhase;
+}
+
+// Orders given as an array of strings or one string with an order per line
+std::vector<std::string> orderLines(napi_env env, napi_value value) {
+  std::vector<std::string> lines;
+  if (IsArray(env, value)) {
+    napi_value ordersArray = value;
+    for (uint32_t i = 0; i < ArrayLength(env, ordersArray); i++) {
+      napi_value orderVal = GetElement(env, ordersArray, i);
+      if (IsString(env, orderVal)) {
+        lines.push_back(ToString(env, orderVal));
+      }
+    }
+  } else if (IsString(env, value)) {
+    std::string orderStr = ToString(env, value);
+    std::istringstream in(orderStr);
+    std::string line;
+    while (std::getline(in, line)) {
+      lines.push_back(line);
+    }
+  }
+  return lines;
+}
+
+// Parse a batch of master commands, skipping blank lines; lines that do
+// not parse are added to `errors`
+std::vector<MasterCommand> masterCommands(const std::vector<std::string>& lines,
+                                          std::vector<MasterBatchError>* errors) {
+  std::vector<MasterCommand> commands;
+  for (const auto& line : lines) {
+    if (line.find_first_not_of(" \t\r") == std::string::npos) {
+      continue;
+    }
+    MasterCommand command;
+    std::string error;
+    if (ParseMasterCommand(line, &command, &error)) {
+      commands.push_back(command);
+    } else {
+      errors->push_back({"", line, error});
+    }
+  }
+  return commands;
+}
+
+// Apply a batch through applyMasterBatch and describe the outcome
+napi_value masterBatchResult(napi_env env, const std::string& master,
+                             const std::vector<std::string>& gameIds,
+                             const std::vector<std::string>& lines, bool checkMaster) {
+  std::vector<MasterBatchError> errors;
+  std::vector<MasterCommand> commands = masterCommands(lines, &errors);
+  uint64_t sequence = 0;
+  bool success = errors.empty() &&
+                 applyMasterBatch(master, gameIds, commands, checkMaster, &errors, &sequence);
+  
+  napi_value errorArray = NewArray(env, errors.size());
+  for (size_t i = 0; i < errors.size(); i++) {
+    napi_value entry = NewObject(env);
+    SetProperty(env, entry, "gameId", NewString(env, errors[i].gameId));
+    SetProperty(env, entry, "command", NewString(env, errors[i].command));
+    SetProperty(env, entry, "error", NewString(env, errors[i].error));
+    SetElement(env, errorArray, static_cast<uint32_t>(i), entry);
+  }
+  
+  napi_value result = NewObject(env);
+  SetProperty(env, result, "success", NewBoolean(env, success));
+  SetProperty(env, result, "sequence", NewNumber(env, static_cast<double>(sequence)));
+  SetProperty(env, result, "errors", errorArray);
+  return result;
+}
+
+// A per-recipient header followed by the shared report, if there is one.
+// The report becomes an external JavaScript string over the engine's own
+// buffer where the runtime supports that, and is copied once otherwise.
+// `reports` holds the string made for each report so far, so a report
+// mailed to every player crosses into JavaScript once, and each header is
+// joined to it by JavaScript's concat rather than copied in C++.
+napi_value withReport(napi_env env, const std::string& header,
+                      const std::shared_ptr<const std::string>& report,
+                      std::map<const std::string*, napi_value>* reports) {
+  if (!report || report->empty()) {
+    return NewString(env, header);
+  }
+  napi_value& shared = (*reports)[report.get()];
+  if (!shared) {
+    shared = NewSharedString(env, report);
+  }
+  if (header.empty()) {
+    return shared;
+  }
+  napi_value text = NewString(env, header);
+  napi_value concat;
+  napi_value joined;
+  if (napi_get_named_property(env, text, "concat", &concat) != napi_ok ||
+      napi_call_function(env, text, concat, 1, &shared, &joined) != napi_ok) {
+    return NewString(env, header + *report);
+  }
+  return joined;
+}
 
 // Initialize the configuration
-void InitConfig(const FunctionCallbackInfo<Value>& args) {
+napi_value InitConfig(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
   // Reset any global state if needed
-  Isolate* isolate = args.GetIsolate();
-  args.GetReturnValue().Set(Boolean::New(isolate, true));
+  return NewBoolean(env, true);
 }
 
 // Game setup functions
-void InitGame(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
-  Local<Context> context = isolate->GetCurrentContext();
+napi_value InitGame(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
   
   // Parse arguments: variant and playerCount
   // Defaults to standard with 7 players if not specified
-  String::Utf8Value variant(isolate, args[0]);
-  int playerCount = args[1]->IsUndefined() 
+  std::string variant = ToString(env, args[0]);
+  int playerCount = IsUndefined(env, args[1]) 
     ? 7 
-    : args[1]->Int32Value(context).FromJust();
+    : ToInt32(env, args[1]);
   
   // Set initial game state
-  currentPhase = "DIPLOMACY";
-  currentSeason = "SPRING";
-  currentYear = 1901;
+  engine->currentPhase = "DIPLOMACY";
+  engine->currentSeason = "SPRING";
+  engine->currentYear = 1901;
   
   // Clear existing players to ensure we start fresh
-  players.clear();
-  playerEmails.clear();
-  outboundEmails.clear();
+  engine->players.clear();
+  engine->playerEmails.clear();
+  engine->playerGames.clear();
+  engine->outboundEmails.clear();
+  engine->pressStores.clear();
+  engine->gameEnds.clear();
+  engine->boards.clear();
+  engine->gameVariants.clear();
+  engine->reportWriters.clear();
+  engine->mapRenderers.clear();
+  engine->latestReports.clear();
+  engine->histories.clear();
+  engine->orderStores.clear();
+  engine->readiness.clear();
+  engine->minimumWaits.clear();
+  engine->adjudicationQueue.Clear();
+  engine->botPlayers.clear();
+  engine->observers.clear();
+  engine->gameControls.clear();
   
   // Create initial players
   for (int i = 0; i < playerCount; ++i) {
@@ -131,33 +939,29 @@ void InitGame(const FunctionCallbackInfo<Value>& args) {
     player.status = 0;
     player.units = 3;
     player.centers = 3;
-    players.push_back(player);
+    engine->players.push_back(player);
   }
   
   // Return success
-  args.GetReturnValue().Set(Boolean::New(isolate, true));
+  return NewBoolean(env, true);
 }
 
-void GetGameState(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
-  Local<Context> context = isolate->GetCurrentContext();
+napi_value GetGameState(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
   
   // Create a JavaScript object to hold the state
-  Local<Object> state = Object::New(isolate);
+  napi_value state = NewObject(env);
   
   // Set phase, season, and year
-  state->Set(context, String::NewFromUtf8(isolate, "phase").ToLocalChecked(),
-             String::NewFromUtf8(isolate, currentPhase.c_str()).ToLocalChecked()).Check();
-  state->Set(context, String::NewFromUtf8(isolate, "season").ToLocalChecked(),
-             String::NewFromUtf8(isolate, currentSeason.c_str()).ToLocalChecked()).Check();
-  state->Set(context, String::NewFromUtf8(isolate, "year").ToLocalChecked(),
-             Number::New(isolate, currentYear)).Check();
+  SetProperty(env, state, "phase", NewString(env, engine->currentPhase));
+  SetProperty(env, state, "season", NewString(env, engine->currentSeason));
+  SetProperty(env, state, "year", NewNumber(env, engine->currentYear));
   
   // Create a JavaScript array to hold the players
-  Local<Array> playerArray = Array::New(isolate);
+  napi_value playerArray = NewArray(env);
   
   // If players array is empty, create default players
-  if (players.empty()) {
+  if (engine->players.empty()) {
     // Create 7 default players
     for (int i = 0; i < 7; ++i) {
       Player player;
@@ -166,571 +970,1369 @@ void GetGameState(const FunctionCallbackInfo<Value>& args) {
       player.units = 3;
       player.centers = 3;
       
-      Local<Object> playerObj = Object::New(isolate);
-      playerObj->Set(context, String::NewFromUtf8(isolate, "power").ToLocalChecked(),
-                   String::NewFromUtf8(isolate, player.power.c_str()).ToLocalChecked()).Check();
-      playerObj->Set(context, String::NewFromUtf8(isolate, "status").ToLocalChecked(),
-                   Number::New(isolate, player.status)).Check();
-      playerObj->Set(context, String::NewFromUtf8(isolate, "units").ToLocalChecked(),
-                   Number::New(isolate, player.units)).Check();
-      playerObj->Set(context, String::NewFromUtf8(isolate, "centers").ToLocalChecked(),
-                   Number::New(isolate, player.centers)).Check();
+      napi_value playerObj = NewObject(env);
+      SetProperty(env, playerObj, "power", NewString(env, player.power));
+      SetProperty(env, playerObj, "status", NewNumber(env, player.status));
+      SetProperty(env, playerObj, "units", NewNumber(env, player.units));
+      SetProperty(env, playerObj, "centers", NewNumber(env, player.centers));
       
-      playerArray->Set(context, i, playerObj).Check();
+      SetElement(env, playerArray, i, playerObj);
     }
   } else {
     // Add each player to the array
-    for (size_t i = 0; i < players.size(); i++) {
-      Local<Object> playerObj = Object::New(isolate);
-      playerObj->Set(context, String::NewFromUtf8(isolate, "power").ToLocalChecked(),
-                   String::NewFromUtf8(isolate, players[i].power.c_str()).ToLocalChecked()).Check();
-      playerObj->Set(context, String::NewFromUtf8(isolate, "status").ToLocalChecked(),
-                   Number::New(isolate, players[i].status)).Check();
-      playerObj->Set(context, String::NewFromUtf8(isolate, "units").ToLocalChecked(),
-                   Number::New(isolate, players[i].units)).Check();
-      playerObj->Set(context, String::NewFromUtf8(isolate, "centers").ToLocalChecked(),
-                   Number::New(isolate, players[i].centers)).Check();
+    for (size_t i = 0; i < engine->players.size(); i++) {
+      napi_value playerObj = NewObject(env);
+      SetProperty(env, playerObj, "power", NewString(env, engine->players[i].power));
+      SetProperty(env, playerObj, "status", NewNumber(env, engine->players[i].status));
+      SetProperty(env, playerObj, "units", NewNumber(env, engine->players[i].units));
+      SetProperty(env, playerObj, "centers", NewNumber(env, engine->players[i].centers));
       
-      playerArray->Set(context, i, playerObj).Check();
+      SetElement(env, playerArray, i, playerObj);
     }
   }
   
   // Add the player array to the state object
-  state->Set(context, String::NewFromUtf8(isolate, "players").ToLocalChecked(), playerArray).Check();
+  SetProperty(env, state, "players", playerArray);
+  
+  // Return the state object
+  return state;
+}
+
+napi_value ValidateOrder(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
+  
+  // Validate if an order is syntactically correct (for demo, return true for any order)
+  return NewBoolean(env, true);
+}
+
+napi_value ProcessOrders(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
+  
+  if (args.Length() < 3) {
+    return ThrowTypeError(env, "Wrong number of arguments");
+  }
+  
+  std::string gameId = ToString(env, args[0]);
+  int playerId = ToInt32(env, args[1]);
+  
+  // This player's orders are the latest for their units; everything
+  // submitted for the phase is adjudicated together
+  storeOrders(gameId, gameBoard(gameId).GetMap().FindPower(playerPower(playerId)),
+              orderLines(env, args[2]), nullptr);
+  
+  // 1 once adjudicated, 0 if the game is paused and the orders only stored
+  return NewNumber(env, adjudicateGame(gameId) < 0 ? 0 : 1);
+}
+
+// Adjudicate every game whose powers are all ready and whose minimum wait
+// is over; returns the IDs of the games adjudicated
+napi_value ProcessAdjudicationQueue(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
+  
+  std::vector<std::string> due = engine->adjudicationQueue.PopDue(nowMs());
+  napi_value result = NewArray(env, static_cast<int>(due.size()));
+  for (size_t i = 0; i < due.size(); i++) {
+    adjudicateGame(due[i]);
+    SetElement(env, result, static_cast<uint32_t>(i), NewString(env, due[i]));
+  }
+  
+  return result;
+}
+
+// Game configuration functions
+
+// Play a game under another variant; only before its first adjudication,
+// since the map and powers change with it
+napi_value SetGameVariant(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
+  
+  if (args.Length() < 2) {
+    return ThrowTypeError(env, "Wrong number of arguments");
+  }
+  
+  std::string variantName = ToString(env, args[0]);
+  std::string gameId = ToString(env, args[1]);
+  
+  const Variant* variant = FindVariant(variantName);
+  auto history = engine->histories.find(gameId);
+  if (!variant || (history != engine->histories.end() && history->second.PhaseCount() > 0)) {
+    return NewBoolean(env, false);
+  }
+  
+  // The board, order slots, readiness and tracked powers are rebuilt for
+  // the new map; victory conditions carry over
+  const GameEndTracker& previous = gameEnd(gameId);
+  bool dias = previous.Dias();
+  int victoryCenters = previous.VictoryCenters();
+  int maxYear = previous.MaxYear();
+  engine->gameVariants[gameId] = variant;
+  engine->boards.erase(gameId);
+  engine->orderStores.erase(gameId);
+  engine->readiness.erase(gameId);
+  engine->gameEnds.erase(gameId);
+  engine->adjudicationQueue.Cancel(gameId);
+  gameEnd(gameId).SetVictoryConditions(dias, victoryCenters, maxYear);
+  auto game = engine->games.find(gameId);
+  if (game != engine->games.end()) {
+    game->second.variant = variant->name;
+    game->second.playerCount = std::min(game->second.playerCount, variant->map->PowerCount());
+  }
+  
+  return NewBoolean(env, true);
+}
+
+napi_value SetPressRules(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
+  
+  if (args.Length() < 2) {
+    return ThrowTypeError(env, "Wrong number of arguments");
+  }
+  
+  std::string pressType = ToString(env, args[0]);
+  std::string gameId = ToString(env, args[1]);
+  
+  // Compile and store the press rules for this game
+  PressPolicy policy;
+  if (!CompilePressRules(pressType, &policy)) {
+    return NewBoolean(env, false);
+  }
+  engine->pressPolicies[gameId] = policy;
+  
+  return NewBoolean(env, true);
+}
+
+napi_value SetDeadlines(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
+  return NewBoolean(env, true);
+}
+
+// Minutes a phase must run before it can be adjudicated early
+napi_value SetMinimumWait(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
+  
+  if (args.Length() < 2) {
+    return ThrowTypeError(env, "Wrong number of arguments");
+  }
+  
+  int minutes = ToInt32(env, args[0]);
+  std::string gameId = ToString(env, args[1]);
+  if (minutes < 0) {
+    return NewBoolean(env, false);
+  }
+  
+  engine->minimumWaits[gameId] = minutes;
+  checkReady(gameId);
+  return NewBoolean(env, true);
+}
+
+napi_value SetVictoryConditions(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
+  
+  if (args.Length() < 2) {
+    return ThrowTypeError(env, "Wrong number of arguments");
+  }
+  
+  bool dias = ToBoolean(env, args[0]);
+  std::string gameId = ToString(env, args[1]);
+  int victoryCenters = args.Length() > 2 && IsNumber(env, args[2])
+    ? ToInt32(env, args[2])
+    : 18;
+  int maxYear = args.Length() > 3 && IsNumber(env, args[3])
+    ? ToInt32(env, args[3])
+    : 0;
+  
+  if (victoryCenters <= 0 || maxYear < 0) {
+    return NewBoolean(env, false);
+  }
+  
+  gameEnd(gameId).SetVictoryConditions(dias, victoryCenters, maxYear);
+  return NewBoolean(env, true);
+}
+
+// Least dedication, on-time and resistance ratings (0 to 5) for a seat
+napi_value SetGameAccess(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
+  
+  if (args.Length() < 4) {
+    return ThrowTypeError(env, "Wrong number of arguments");
+  }
+  
+  std::string command = "SET ACCESS " + ToString(env, args[0]) + " " + ToString(env, args[1]) +
+                        " " + ToString(env, args[2]);
+  std::string gameId = ToString(env, args[3]);
+  
+  napi_value result = masterBatchResult(env, "", {gameId}, {command}, false);
+  return GetProperty(env, result, "success");
+}
+
+// Player interaction functions
+napi_value RegisterPlayer(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
+  
+  if (args.Length() < 4) {
+    return ThrowTypeError(env, "Wrong number of arguments");
+  }
+  
+  std::string name = ToString(env, args[0]);
+  std::string email = ToString(env, args[1]);
+  std::string power = ToString(env, args[2]);
+  std::string gameId = ToString(env, args[3]);
+  
+  int playerId = newPlayerId();
+  
+  // Store player information
+  // For this demo, we'll use the status field to store the player ID
+  Player newPlayer;
+  newPlayer.power = power;
+  newPlayer.status = playerId; // Use status to store player ID for demo
+  newPlayer.units = 3;
+  newPlayer.centers = 3;
+  
+  // Take the power's units and centers from the game's board
+  const Board& board = gameBoard(gameId);
+  int powerIndex = board.GetMap().FindPower(newPlayer.power);
+  if (powerIndex >= 0) {
+    newPlayer.units = board.UnitCount(powerIndex);
+    newPlayer.centers = board.CenterCount(powerIndex);
+  }
+  engine->players.push_back(newPlayer);
+  
+  // Store player email in our map
+  engine->playerEmails[playerId] = email;
+  engine->playerGames[playerId] = gameId;
+  checkReady(gameId);
+  
+  napi_value result = NewObject(env);
+  SetProperty(env, result, "success", NewBoolean(env, true));
+  SetProperty(env, result, "playerId", NewNumber(env, playerId));
+  
+  return result;
+}
+
+napi_value GetPlayerStatus(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
+  
+  if (args.Length() < 2) {
+    return ThrowTypeError(env, "Wrong number of arguments");
+  }
+  
+  int playerId = ToInt32(env, args[0]);
+  std::string gameId = ToString(env, args[1]);
+  
+  // Units and centers come from the game's board; a seat handed to the bot
+  // is reported as such until it is taken back. A player seated in another
+  // game, or in none, is unknown to this one.
+  auto seat = engine->playerGames.find(playerId);
+  bool seated = seat != engine->playerGames.end() && seat->second == gameId;
+  std::string power = seated ? playerPower(playerId) : "";
+  const Board* board = seated ? &gameBoard(gameId) : nullptr;
+  int index = seated ? board->GetMap().FindPower(power) : -1;
+  std::string state = "UNKNOWN";
+  if (index >= 0) {
+    auto bots = engine->botPlayers.find(gameId);
+    bool bot = bots != engine->botPlayers.end() && bots->second.count(index);
+    state = bot ? "BOT" : "ACTIVE";
+  }
+  
+  napi_value status = NewObject(env);
+  SetProperty(env, status, "power", NewString(env, power));
+  SetProperty(env, status, "status", NewString(env, state));
+  SetProperty(env, status, "units", NewNumber(env, index >= 0 ? board->UnitCount(index) : 0));
+  SetProperty(env, status, "centers", NewNumber(env, index >= 0 ? board->CenterCount(index) : 0));
+  
+  return status;
+}
+
+napi_value SendPress(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
+  
+  if (args.Length() < 4) {
+    return ThrowTypeError(env, "Wrong number of arguments");
+  }
+  
+  int senderId = ToInt32(env, args[0]);
+  std::string message = ToString(env, args[2]);
+  std::string gameId = ToString(env, args[3]);
+  
+  // Options are either a grey flag or an object of press flags
+  bool grey = false;
+  bool fake = false;
+  if (args.Length() > 4 && IsObject(env, args[4])) {
+    napi_value options = args[4];
+    grey = ToBoolean(env, GetProperty(env, options, "grey"));
+    fake = ToBoolean(env, GetProperty(env, options, "fake"));
+  } else if (args.Length() > 4) {
+    grey = ToBoolean(env, args[4]);
+  }
+  
+  
+  // Recipient is a player ID (0 for broadcast) or a list of power names
+  bool broadcast = false;
+  std::vector<std::string> recipientPowers;
+  if (IsNumber(env, args[1])) {
+    int recipientId = ToInt32(env, args[1]);
+    if (recipientId == 0) {
+      broadcast = true;
+    } else {
+      recipientPowers.push_back(playerPower(recipientId));
+    }
+  } else {
+    std::string recipientVal = ToString(env, args[1]);
+    std::string recipientList = upperCase(recipientVal);
+    std::string power;
+    for (size_t i = 0; i <= recipientList.size(); ++i) {
+      if (i == recipientList.size() || recipientList[i] == ',' || recipientList[i] == ' ') {
+        if (!power.empty()) {
+          recipientPowers.push_back(power);
+          power.clear();
+        }
+      } else {
+        power += recipientList[i];
+      }
+    }
+    broadcast = recipientPowers.size() == 1 && recipientPowers[0] == "ALL";
+  }
+  
+  // Check the message against the game's press rules
+  std::string senderPower = playerPower(senderId);
+  fake = fake && !broadcast;
+  uint32_t required = PressRequirements(grey, broadcast, fake, senderPower.empty(),
+                                        PressPhaseFlag(engine->currentPhase));
+  if (!PressAllowed(gamePressPolicy(gameId), required)) {
+    napi_value result = NewObject(env);
+    SetProperty(env, result, "success", NewBoolean(env, false));
+    return result;
+  }
+  
+  // Record the message in the game's press log
+  uint32_t messageId = engine->pressStores[gameId].Append(
+      senderId, senderPower, broadcast ? PRESS_BROADCAST : PRESS_PARTIAL,
+      grey, fake, recipientPowers, phaseLabel(), message);
+  
+  // Find sender and recipient email from our player map
+  std::string senderEmail = engine->playerEmails[senderId];
+  if (senderEmail.empty()) {
+    senderEmail = "unknown@example.com";
+  }
+  
+  // Create an outbound email, hiding the sender of grey press
+  Email email;
+  email.from = grey ? "system@diplomacy.net" : senderEmail;
+  email.subject = std::string(fake ? "Broadcast" : "Press") + " from " +
+                  (grey ? "Anonymous" : senderEmail);
+  auto body = std::make_shared<const std::string>(message);
+  email.report = body; // Shared by every recipient's copy
+  
+  if (broadcast) {
+    // Broadcast to all players
+    email.to = "all-players@diplomacy.net";
+    engine->outboundEmails.push_back(email);
+    
+    // Also create individual emails for each player
+    for (const auto& pair : engine->playerEmails) {
+      if (pair.first != senderId) { // Don't send to self
+        Email individualEmail = email;
+        individualEmail.to = pair.second;
+        engine->outboundEmails.push_back(individualEmail);
+      }
+    }
+    
+    // Broadcasts are public: watchers get them too
+    publishView(gameId, gameBoard(gameId).PhaseName(), email.subject, body);
+  } else {
+    // Direct message to each named player
+    for (const auto& power : recipientPowers) {
+      int recipientId = powerPlayerId(power);
+      std::string recipientEmail = recipientId >= 0 ? engine->playerEmails[recipientId] : "";
+      if (recipientEmail.empty()) {
+        recipientEmail = "unknown@example.com";
+      }
+      
+      Email individualEmail = email;
+      individualEmail.to = recipientEmail;
+      engine->outboundEmails.push_back(individualEmail);
+    }
+  }
+  
+  napi_value result = NewObject(env);
+  SetProperty(env, result, "success", NewBoolean(env, true));
+  SetProperty(env, result, "messageId", NewNumber(env, messageId));
+  
+  return result;
+}
+
+// Convert a stored press message to a JavaScript object as seen by `reader`
+napi_value pressMessageObject(napi_env env, const PressMessage& msg,
+                                 const std::string& reader) {
+  
+  napi_value to = NewArray(env, msg.recipients.size());
+  for (size_t i = 0; i < msg.recipients.size(); i++) {
+    SetElement(env, to, i, NewString(env, msg.recipients[i]));
+  }
+  
+  std::string from = PressStore::ShowsSender(msg, reader) ? msg.senderPower : "Anonymous";
+  
+  // Fake broadcasts look like real ones to everybody but the sender
+  bool broadcast = msg.kind == PRESS_BROADCAST || (msg.fake && msg.senderPower != reader);
+  if (msg.fake && msg.senderPower != reader) {
+    to = NewArray(env);
+  }
+  
+  napi_value msgObj = NewObject(env);
+  SetProperty(env, msgObj, "id", NewNumber(env, msg.seq));
+  SetProperty(env, msgObj, "from", NewString(env, from));
+  SetProperty(env, msgObj, "to", to);
+  SetProperty(env, msgObj, "broadcast", NewBoolean(env, broadcast));
+  SetProperty(env, msgObj, "grey", NewBoolean(env, msg.grey));
+  SetProperty(env, msgObj, "phase", NewString(env, msg.phase));
+  SetProperty(env, msgObj, "body", NewString(env, msg.body));
+  
+  return msgObj;
+}
+
+napi_value GetPressHistory(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
+  
+  if (args.Length() < 2) {
+    return ThrowTypeError(env, "Wrong number of arguments");
+  }
+  
+  std::string gameId = ToString(env, args[0]);
+  int playerId = ToInt32(env, args[1]);
+  int offset = args.Length() > 2 && IsNumber(env, args[2]) ? ToInt32(env, args[2]) : 0;
+  int limit = args.Length() > 3 && IsNumber(env, args[3]) ? ToInt32(env, args[3]) : 50;
+  
+  std::string reader = playerPower(playerId);
+  const PressStore& store = engine->pressStores[gameId];
+  std::vector<const PressMessage*> page =
+      store.Mailbox(reader, offset > 0 ? offset : 0, limit > 0 ? limit : 0);
+  
+  napi_value messages = NewArray(env, page.size());
+  for (size_t i = 0; i < page.size(); i++) {
+    SetElement(env, messages, i, pressMessageObject(env, *page[i], reader));
+  }
+  
+  napi_value result = NewObject(env);
+  SetProperty(env, result, "total", NewNumber(env, store.MailboxSize(reader)));
+  SetProperty(env, result, "messages", messages);
+  
+  return result;
+}
+
+napi_value SearchPress(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
+  
+  if (args.Length() < 3) {
+    return ThrowTypeError(env, "Wrong number of arguments");
+  }
+  
+  std::string gameId = ToString(env, args[0]);
+  int playerId = ToInt32(env, args[1]);
+  std::string queryVal = ToString(env, args[2]);
+  int limit = args.Length() > 3 && IsNumber(env, args[3]) ? ToInt32(env, args[3]) : 50;
+  
+  std::string reader = playerPower(playerId);
+  std::vector<const PressMessage*> matches = engine->pressStores[gameId].Search(
+      reader, queryVal, limit > 0 ? limit : 0);
+  
+  napi_value messages = NewArray(env, matches.size());
+  for (size_t i = 0; i < matches.size(); i++) {
+    SetElement(env, messages, i, pressMessageObject(env, *matches[i], reader));
+  }
+  
+  return messages;
+}
+
+napi_value VoteForDraw(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
+  
+  if (args.Length() < 3) {
+    return ThrowTypeError(env, "Wrong number of arguments");
+  }
+  
+  int playerId = ToInt32(env, args[0]);
+  bool vote = ToBoolean(env, args[1]);
+  std::string gameId = ToString(env, args[2]);
+  
+  GameEndTracker& tracker = gameEnd(gameId);
+  
+  // Without DIAS a vote may name the powers to share the draw
+  PowerSet drawSet = 0;
+  bool valid = true;
+  if (args.Length() > 3 && IsArray(env, args[3])) {
+    napi_value powers = args[3];
+    for (uint32_t i = 0; i < ArrayLength(env, powers); i++) {
+      std::string power = ToString(env, GetElement(env, powers, i));
+      int slot = tracker.PowerSlot(upperCase(power));
+      if (slot < 0) {
+        valid = false;
+        break;
+      }
+      drawSet |= PowerSet(1) << slot;
+    }
+  }
+  
+  int slot = tracker.PowerSlot(playerPower(playerId));
+  bool success = valid && tracker.VoteDraw(slot, vote, drawSet);
+  
+  napi_value result = NewObject(env);
+  SetProperty(env, result, "success", NewBoolean(env, success));
+  SetProperty(env, result, "drawAccepted", NewBoolean(env, tracker.Result() == GAME_RESULT_DRAW));
+  
+  return result;
+}
+
+napi_value ConcedeGame(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
+  
+  if (args.Length() < 3) {
+    return ThrowTypeError(env, "Wrong number of arguments");
+  }
+  
+  int playerId = ToInt32(env, args[0]);
+  std::string gameId = ToString(env, args[2]);
+  
+  GameEndTracker& tracker = gameEnd(gameId);
+  
+  // A null winner withdraws the concession
+  int winner = -1;
+  bool valid = true;
+  if (!IsNull(env, args[1]) && !IsUndefined(env, args[1])) {
+    std::string power = ToString(env, args[1]);
+    winner = tracker.PowerSlot(upperCase(power));
+    valid = winner >= 0;
+  }
+  
+  bool success = valid && tracker.Concede(tracker.PowerSlot(playerPower(playerId)), winner);
+  
+  napi_value result = NewObject(env);
+  SetProperty(env, result, "success", NewBoolean(env, success));
+  
+  return result;
+}
+
+napi_value GetGameResult(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
+  
+  if (args.Length() < 1) {
+    return ThrowTypeError(env, "Wrong number of arguments");
+  }
+  
+  std::string gameId = ToString(env, args[0]);
+  const GameEndTracker& tracker = gameEnd(gameId);
+  
+  static const char* resultNames[] = {"none", "victory", "draw", "concession"};
+  
+  napi_value winners = NewArray(env);
+  uint32_t count = 0;
+  for (int slot = 0; slot < tracker.PowerCount(); ++slot) {
+    if (tracker.Winners() & (PowerSet(1) << slot)) {
+      SetElement(env, winners, count++, NewString(env, tracker.PowerName(slot)));
+    }
+  }
+  
+  napi_value result = NewObject(env);
+  SetProperty(env, result, "finished", NewBoolean(env, tracker.Result() != GAME_RESULT_NONE));
+  SetProperty(env, result, "result", NewString(env, resultNames[tracker.Result()]));
+  SetProperty(env, result, "winners", winners);
+  
+  return result;
+}
+
+napi_value SubmitOrders(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
+  
+  if (args.Length() < 3) {
+    return ThrowTypeError(env, "Wrong number of arguments");
+  }
+  
+  int playerId = ToInt32(env, args[0]);
+  std::string gameId = ToString(env, args[2]);
+  
+  // Only a player seated in the game may order, and only for their power
+  int power = seatPower(gameId, playerId);
+  if (power < 0) {
+    napi_value result = NewObject(env);
+    SetProperty(env, result, "success", NewBoolean(env, false));
+    SetProperty(env, result, "ordersAccepted", NewBoolean(env, false));
+    SetProperty(env, result, "version", NewNumber(env, 0));
+    SetProperty(env, result, "rejected", NewArray(env));
+    SetProperty(env, result, "ready", NewBoolean(env, false));
+    SetProperty(env, result, "error", NewString(env, "Player has no power in this game"));
+    return result;
+  }
+  
+  // Valid orders are stored even when others in the same submission fail
+  std::vector<std::pair<std::string, std::string>> rejected;
+  storeOrders(gameId, power, orderLines(env, args[1]), &rejected);
+  checkReady(gameId, power);
+  
+  const Board& board = gameBoard(gameId);
+  auto submission = gameOrders(gameId).Latest(power, board.PhaseName());
+  
+  napi_value rejectedArray = NewArray(env, static_cast<int>(rejected.size()));
+  for (size_t i = 0; i < rejected.size(); i++) {
+    napi_value entry = NewObject(env);
+    SetProperty(env, entry, "order", NewString(env, rejected[i].first));
+    SetProperty(env, entry, "error", NewString(env, rejected[i].second));
+    SetElement(env, rejectedArray, static_cast<uint32_t>(i), entry);
+  }
   
-  // Return the state object
-  args.GetReturnValue().Set(state);
-}
-
-void ValidateOrder(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
+  napi_value result = NewObject(env);
+  SetProperty(env, result, "success", NewBoolean(env, true));
+  SetProperty(env, result, "ordersAccepted", NewBoolean(env, rejected.empty()));
+  SetProperty(env, result, "version", NewNumber(env, submission ? static_cast<double>(submission->version) : 0));
+  SetProperty(env, result, "rejected", rejectedArray);
+  SetProperty(env, result, "ready", NewBoolean(env, power >= 0 && gameReadiness(gameId).Ready(power)));
   
-  // Validate if an order is syntactically correct (for demo, return true for any order)
-  args.GetReturnValue().Set(Boolean::New(isolate, true));
+  return result;
 }
 
-void ProcessOrders(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
-  Local<Context> context = isolate->GetCurrentContext();
+// Orders a player has submitted for the current phase and the units of
+// their power still without one
+napi_value GetSubmittedOrders(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
   
-  if (args.Length() < 3) {
-    isolate->ThrowException(Exception::TypeError(
-        String::NewFromUtf8(isolate, "Wrong number of arguments").ToLocalChecked()));
-    return;
+  if (args.Length() < 2) {
+    return ThrowTypeError(env, "Wrong number of arguments");
   }
   
-  String::Utf8Value gameIdVal(isolate, args[0]);
-  int playerId = args[1]->Int32Value(context).FromJust();
-  
-  // Check if third argument is an array of orders
-  if (args[2]->IsArray()) {
-    Local<Array> ordersArray = Local<Array>::Cast(args[2]);
-    
-    // Process each order in the array
-    for (uint32_t i = 0; i < ordersArray->Length(); i++) {
-      Local<Value> orderVal = ordersArray->Get(context, i).ToLocalChecked();
-      if (orderVal->IsString()) {
-        String::Utf8Value orderStr(isolate, orderVal);
-        // Process order here (in a real implementation)
+  std::string gameId = ToString(env, args[0]);
+  int playerId = ToInt32(env, args[1]);
+  
+  const Board& board = gameBoard(gameId);
+  const Map& map = board.GetMap();
+  int power = map.FindPower(playerPower(playerId));
+  auto submission = gameOrders(gameId).Latest(power, board.PhaseName());
+  
+  napi_value orders = NewArray(env);
+  std::vector<bool> ordered(map.ProvinceCount());
+  if (submission) {
+    for (size_t i = 0; i < submission->orders.size(); i++) {
+      const Order& order = submission->orders[i];
+      std::string text = FormatOrder(map, order);
+      SetElement(env, orders, static_cast<uint32_t>(i), NewString(env, text));
+      if (order.type != ORDER_WAIVE) {
+        ordered[order.unit.province] = true;
       }
     }
-  } else if (args[2]->IsString()) {
-    // Process single order string
-    String::Utf8Value orderStr(isolate, args[2]);
-    // Process order here
   }
   
-  // After processing orders, advance the game state
-  if (currentSeason == "Spring") {
-    currentSeason = "Fall";
-  } else {
-    currentSeason = "Spring";
-    currentYear++;
+  // Only movement and retreats need an order from every unit
+  napi_value missing = NewArray(env);
+  uint32_t missingCount = 0;
+  if (power >= 0 && board.phase == PHASE_MOVEMENT) {
+    for (ProvinceId p = 0; p < map.ProvinceCount(); ++p) {
+      const Unit& unit = board.units[p];
+      if (unit.power == power && !ordered[p]) {
+        std::string text = std::string(unit.type == UNIT_ARMY ? "A " : "F ") +
+                           map.LocationName(Location{p, unit.coast});
+        SetElement(env, missing, missingCount++, NewString(env, text));
+      }
+    }
+  } else if (power >= 0 && board.phase == PHASE_RETREAT) {
+    for (const DislodgedUnit& unit : board.dislodged) {
+      if (unit.power == power && !ordered[unit.location.province]) {
+        std::string text = std::string(unit.type == UNIT_ARMY ? "A " : "F ") +
+                           map.LocationName(unit.location);
+        SetElement(env, missing, missingCount++, NewString(env, text));
+      }
+    }
   }
   
-  // Return success
-  args.GetReturnValue().Set(Number::New(isolate, 1));
+  napi_value result = NewObject(env);
+  SetProperty(env, result, "phase", NewString(env, board.PhaseName()));
+  SetProperty(env, result, "version", NewNumber(env, submission ? static_cast<double>(submission->version) : 0));
+  SetProperty(env, result, "orders", orders);
+  SetProperty(env, result, "missing", missing);
+  SetProperty(env, result, "ready", NewBoolean(env, power >= 0 && gameReadiness(gameId).Ready(power)));
+  
+  return result;
 }
 
-// Game configuration functions
-void SetGameVariant(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
-  args.GetReturnValue().Set(Boolean::New(isolate, true));
-}
+// Search for a power's orders on the game's current board, for bots and
+// for players who want a suggestion
+// Longest a search may take, whether asked for directly or by a bot at an
+// adjudication; either way it runs on the JavaScript thread
+const int kMaxBotBudgetMs = 1000;
 
-void SetPressRules(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
+napi_value SearchOrders(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
   
   if (args.Length() < 2) {
-    isolate->ThrowException(Exception::TypeError(
-        String::NewFromUtf8(isolate, "Wrong number of arguments").ToLocalChecked()));
-    return;
+    return ThrowTypeError(env, "Wrong number of arguments");
   }
   
-  String::Utf8Value pressType(isolate, args[0]);
-  String::Utf8Value gameId(isolate, args[1]);
+  std::string gameId = ToString(env, args[0]);
+  std::string powerVal = ToString(env, args[1]);
   
-  // Store the press rules for this game
-  pressRules[std::string(*gameId)] = std::string(*pressType);
+  // The budget is capped like a bot's; threads, if given, must be at
+  // least one and are capped at the hardware threads
+  SearchOptions options;
+  if (args.Length() > 2 && IsNumber(env, args[2])) {
+    options.timeBudgetMs = std::max(0, std::min(ToInt32(env, args[2]), kMaxBotBudgetMs));
+  }
+  bool validThreads = true;
+  if (args.Length() > 3 && IsNumber(env, args[3])) {
+    options.threads = ToInt32(env, args[3]);
+    validThreads = options.threads >= 1;
+  }
   
-  args.GetReturnValue().Set(Boolean::New(isolate, true));
-}
-
-void SetDeadlines(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
-  args.GetReturnValue().Set(Boolean::New(isolate, true));
-}
-
-void SetVictoryConditions(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
-  args.GetReturnValue().Set(Boolean::New(isolate, true));
+  const Board& board = gameBoard(gameId);
+  int power = board.GetMap().FindPower(powerVal);
+  SearchResult search;
+  if (power >= 0 && validThreads) {
+    search = SearchOrders(board, power, options);
+  }
+  
+  napi_value orders = NewArray(env, static_cast<int>(search.orders.size()));
+  for (size_t i = 0; i < search.orders.size(); i++) {
+    std::string text = FormatOrder(board.GetMap(), search.orders[i]);
+    SetElement(env, orders, static_cast<uint32_t>(i), NewString(env, text));
+  }
+  
+  napi_value result = NewObject(env);
+  SetProperty(env, result, "orders", orders);
+  SetProperty(env, result, "score", NewNumber(env, search.orders.empty() ? 0 : search.score));
+  SetProperty(env, result, "evaluations", NewNumber(env, static_cast<double>(search.evaluations)));
+  SetProperty(env, result, "threads", NewNumber(env, search.threads));
+  
+  return result;
 }
 
-void SetGameAccess(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
-  args.GetReturnValue().Set(Boolean::New(isolate, true));
+// Hand an abandoned seat to the bot, which orders for it at every
+// adjudication with the given time budget (at most kMaxBotBudgetMs); a
+// budget of 0 takes it back
+napi_value SetBotPlayer(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
+  
+  if (args.Length() < 3) {
+    return ThrowTypeError(env, "Wrong number of arguments");
+  }
+  
+  std::string gameId = ToString(env, args[0]);
+  std::string powerVal = ToString(env, args[1]);
+  int timeBudgetMs = std::min(ToInt32(env, args[2]), kMaxBotBudgetMs);
+  
+  int power = gameBoard(gameId).GetMap().FindPower(powerVal);
+  if (power < 0) {
+    return NewBoolean(env, false);
+  }
+  if (timeBudgetMs > 0) {
+    engine->botPlayers[gameId][power] = timeBudgetMs;
+  } else {
+    engine->botPlayers[gameId].erase(power);
+  }
+  checkReady(gameId);
+  return NewBoolean(env, true);
 }
 
-// Player interaction functions
-void RegisterPlayer(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
-  Local<Context> context = isolate->GetCurrentContext();
+// Watch a game: results, positions and broadcast press as they are
+// published, or `delayPhases` phases behind for a delayed spectator
+napi_value AddObserver(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
   
-  if (args.Length() < 4) {
-    isolate->ThrowException(Exception::TypeError(
-        String::NewFromUtf8(isolate, "Wrong number of arguments").ToLocalChecked()));
-    return;
+  if (args.Length() < 2) {
+    return ThrowTypeError(env, "Wrong number of arguments");
   }
   
-  String::Utf8Value name(isolate, args[0]);
-  String::Utf8Value email(isolate, args[1]);
-  String::Utf8Value power(isolate, args[2]);
-  String::Utf8Value gameId(isolate, args[3]);
-  
-  // Generate a random player ID between 100 and 999
-  std::random_device rd;
-  std::mt19937 gen(rd());
-  std::uniform_int_distribution<> dis(100, 999);
-  int playerId = dis(gen);
+  std::string gameId = ToString(env, args[0]);
+  std::string address = ToString(env, args[1]);
+  int delayPhases = args.Length() > 2 && IsNumber(env, args[2])
+      ? ToInt32(env, args[2]) : 0;
+  if (address.length() == 0 || delayPhases < 0) {
+    return NewBoolean(env, false);
+  }
   
-  // Store player information
-  // For this demo, we'll use the status field to store the player ID
-  Player newPlayer;
-  newPlayer.power = std::string(*power);
-  newPlayer.status = playerId; // Use status to store player ID for demo
-  newPlayer.units = 3;
-  newPlayer.centers = 3;
-  players.push_back(newPlayer);
+  engine->observers[gameId].Subscribe(address, delayPhases);
+  return NewBoolean(env, true);
+}
+
+napi_value RemoveObserver(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
   
-  // Store player email in our map
-  playerEmails[playerId] = std::string(*email);
+  if (args.Length() < 2) {
+    return ThrowTypeError(env, "Wrong number of arguments");
+  }
   
-  Local<Object> result = Object::New(isolate);
-  result->Set(context, String::NewFromUtf8(isolate, "success").ToLocalChecked(), 
-              Boolean::New(isolate, true)).Check();
-  result->Set(context, String::NewFromUtf8(isolate, "playerId").ToLocalChecked(), 
-              Number::New(isolate, playerId)).Check();
+  std::string gameId = ToString(env, args[0]);
+  std::string address = ToString(env, args[1]);
   
-  args.GetReturnValue().Set(result);
+  auto it = engine->observers.find(gameId);
+  bool removed = it != engine->observers.end() && it->second.Unsubscribe(address);
+  return NewBoolean(env, removed);
 }
 
-void GetPlayerStatus(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
-  Local<Context> context = isolate->GetCurrentContext();
+napi_value ListObservers(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
+  
+  if (args.Length() < 1) {
+    return ThrowTypeError(env, "Wrong number of arguments");
+  }
   
-  Local<Object> status = Object::New(isolate);
-  status->Set(context, String::NewFromUtf8(isolate, "power").ToLocalChecked(), 
-              String::NewFromUtf8(isolate, "FRANCE").ToLocalChecked()).Check();
-  status->Set(context, String::NewFromUtf8(isolate, "status").ToLocalChecked(), 
-              String::NewFromUtf8(isolate, "ACTIVE").ToLocalChecked()).Check();
-  status->Set(context, String::NewFromUtf8(isolate, "units").ToLocalChecked(), 
-              Number::New(isolate, 3)).Check();
-  status->Set(context, String::NewFromUtf8(isolate, "centers").ToLocalChecked(), 
-              Number::New(isolate, 3)).Check();
+  std::string gameId = ToString(env, args[0]);
+  
+  napi_value result = NewArray(env);
+  auto it = engine->observers.find(gameId);
+  if (it != engine->observers.end()) {
+    uint32_t i = 0;
+    for (const auto& watcher : it->second.Watchers()) {
+      napi_value entry = NewObject(env);
+      SetProperty(env, entry, "address", NewString(env, watcher.first));
+      SetProperty(env, entry, "delay", NewNumber(env, watcher.second));
+      SetElement(env, result, i++, entry);
+    }
+  }
   
-  args.GetReturnValue().Set(status);
+  return result;
 }
 
-void SendPress(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
-  Local<Context> context = isolate->GetCurrentContext();
+// A game of a known variant for up to one player per power; the player
+// count may be given as a number or a string of digits, and is a player
+// for every power if left out
+napi_value CreateGame(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
   
-  if (args.Length() < 4) {
-    isolate->ThrowException(Exception::TypeError(
-        String::NewFromUtf8(isolate, "Wrong number of arguments").ToLocalChecked()));
-    return;
+  if (args.Length() < 2) {
+    return ThrowTypeError(env, "Wrong number of arguments");
   }
   
-  int senderId = args[0]->Int32Value(context).FromJust();
-  int recipientId = args[1]->IsNumber() ? args[1]->Int32Value(context).FromJust() : -1;
-  String::Utf8Value messageVal(isolate, args[2]);
-  String::Utf8Value gameIdVal(isolate, args[3]);
+  std::string variant = ToString(env, args[0]);
+  std::string name = ToString(env, args[1]);
   
-  std::string gameId = std::string(*gameIdVal);
-  std::string message = std::string(*messageVal);
+  auto refuse = [env](const std::string& error) {
+    napi_value result = NewObject(env);
+    SetProperty(env, result, "success", NewBoolean(env, false));
+    SetProperty(env, result, "gameId", NewString(env, ""));
+    SetProperty(env, result, "error", NewString(env, error));
+    return result;
+  };
   
-  // Check if this game has no-press rules
-  auto it = pressRules.find(gameId);
-  if (it != pressRules.end() && it->second == "none") {
-    // No press allowed in this game
-    Local<Object> result = Object::New(isolate);
-    result->Set(context, String::NewFromUtf8(isolate, "success").ToLocalChecked(), 
-                Boolean::New(isolate, false)).Check();
-    args.GetReturnValue().Set(result);
-    return;
+  const Variant* setup = FindVariant(variant);
+  if (!setup) {
+    return refuse("Unknown variant " + variant);
   }
   
-  // Find sender and recipient email from our player map
-  std::string senderEmail = playerEmails[senderId];
-  if (senderEmail.empty()) {
-    senderEmail = "unknown@example.com";
+  int seats = setup->map->PowerCount();
+  long playerCount = 0;
+  if (IsUndefined(env, args[2])) {
+    playerCount = seats;
+  } else if (IsNumber(env, args[2])) {
+    double count = ToNumber(env, args[2]);
+    playerCount = count == static_cast<long>(count) ? static_cast<long>(count) : 0;
+  } else if (IsString(env, args[2])) {
+    std::string count = ToString(env, args[2]);
+    char* end = nullptr;
+    playerCount = std::strtol(count.c_str(), &end, 10);
+    if (count.empty() || *end != '\0') {
+      playerCount = 0;
+    }
+  }
+  if (playerCount < 1 || playerCount > seats) {
+    return refuse("Player count must be from 1 to " + std::to_string(seats));
   }
   
-  // Create an outbound email
-  Email email;
-  email.from = senderEmail;
-  email.subject = "Press from " + senderEmail;
-  email.body = message;
+  std::string gameId = newGameId();
+  engine->gameVariants[gameId] = setup;
   
-  if (recipientId == 0) {
-    // Broadcast to all players
-    email.to = "all-players@diplomacy.net";
-    outboundEmails.push_back(email);
+  // The game starts from its variant's template; its board is shared with
+  // the variant's starting position until first adjudicated
+  GameDetails game = gameTemplate(*setup);
+  game.id = gameId;
+  game.name = name;
+  game.playerCount = static_cast<int>(playerCount);
+  engine->games[gameId] = std::move(game);
+  gameEnd(gameId);
+  
+  napi_value result = NewObject(env);
+  SetProperty(env, result, "success", NewBoolean(env, true));
+  SetProperty(env, result, "gameId", NewString(env, gameId));
+  
+  return result;
+}
+
+napi_value ListGames(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
+  
+  napi_value gameList = NewArray(env, engine->games.size());
+  
+  int i = 0;
+  for (const auto& pair : engine->games) {
+    const GameDetails& game = pair.second;
     
-    // Also create individual emails for each player
-    for (const auto& pair : playerEmails) {
-      if (pair.first != senderId) { // Don't send to self
-        Email individualEmail = email;
-        individualEmail.to = pair.second;
-        outboundEmails.push_back(individualEmail);
-      }
-    }
-  } else {
-    // Direct message to specific player
-    std::string recipientEmail = playerEmails[recipientId];
-    if (recipientEmail.empty()) {
-      recipientEmail = "unknown@example.com";
-    }
+    napi_value gameObj = NewObject(env);
+    SetProperty(env, gameObj, "id", NewString(env, game.id));
+    SetProperty(env, gameObj, "name", NewString(env, game.name));
+    SetProperty(env, gameObj, "phase", NewString(env, game.phase));
+    SetProperty(env, gameObj, "players", NewNumber(env, game.players.size()));
     
-    email.to = recipientEmail;
-    outboundEmails.push_back(email);
+    SetElement(env, gameList, i++, gameObj);
   }
   
-  Local<Object> result = Object::New(isolate);
-  result->Set(context, String::NewFromUtf8(isolate, "success").ToLocalChecked(), 
-              Boolean::New(isolate, true)).Check();
-  
-  args.GetReturnValue().Set(result);
+  return gameList;
 }
 
-void VoteForDraw(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
-  Local<Context> context = isolate->GetCurrentContext();
+// A created game's settings from its template, where it stands, and who
+// holds each power; null for a game that was never created
+napi_value GetGameDetails(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
+  
+  if (args.Length() < 1) {
+    return ThrowTypeError(env, "Wrong number of arguments");
+  }
   
-  Local<Object> result = Object::New(isolate);
-  result->Set(context, String::NewFromUtf8(isolate, "success").ToLocalChecked(), 
-              Boolean::New(isolate, true)).Check();
+  std::string gameId = ToString(env, args[0]);
+  auto found = engine->games.find(gameId);
+  if (found == engine->games.end()) {
+    return Null(env);
+  }
+  const GameDetails& game = found->second;
+  const Board& board = gameBoard(gameId);
+  const Map& map = board.GetMap();
+  auto history = engine->histories.find(gameId);
+  bool started = history != engine->histories.end() && history->second.PhaseCount() > 0;
+  
+  napi_value details = NewObject(env);
+  SetProperty(env, details, "id", NewString(env, game.id));
+  SetProperty(env, details, "name", NewString(env, game.name));
+  SetProperty(env, details, "variant", NewString(env, game.variant));
+  SetProperty(env, details, "phase", NewString(env, seasonName(board.season)));
+  SetProperty(env, details, "year", NewNumber(env, board.year));
+  SetProperty(env, details, "players", NewNumber(env, game.playerCount));
+  SetProperty(env, details, "started", NewBoolean(env, started));
+  SetProperty(env, details, "press", NewString(env, game.press));
+  SetProperty(env, details, "deadline", NewString(env, std::to_string(game.deadline) + "h"));
+  SetProperty(env, details, "graceTime", NewString(env, std::to_string(game.graceTime) + "h"));
+  SetProperty(env, details, "victoryConditions", NewString(env, game.victoryConditions));
+  SetProperty(env, details, "startTime", NewString(env, game.startTime));
+  
+  // Every power of the map, with the address of whoever holds it
+  std::vector<std::string> holders(map.PowerCount());
+  for (const Player* player : gamePlayers(gameId)) {
+    int power = map.FindPower(player->power);
+    if (power >= 0) {
+      holders[power] = engine->playerEmails[player->status];
+    }
+  }
+  auto bots = engine->botPlayers.find(gameId);
+  napi_value playerList = NewArray(env, map.PowerCount());
+  for (int power = 0; power < map.PowerCount(); ++power) {
+    bool bot = bots != engine->botPlayers.end() && bots->second.count(power);
+    napi_value player = NewObject(env);
+    SetProperty(env, player, "power", NewString(env, map.PowerKey(power)));
+    SetProperty(env, player, "status", NewString(env, bot ? "BOT" : holders[power].empty() ? "OPEN" : "ACTIVE"));
+    SetProperty(env, player, "player", NewString(env, holders[power]));
+    SetElement(env, playerList, static_cast<uint32_t>(power), player);
+  }
+  SetProperty(env, details, "playerList", playerList);
   
-  args.GetReturnValue().Set(result);
+  return details;
 }
 
-void SubmitOrders(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
-  Local<Context> context = isolate->GetCurrentContext();
+// Change a game's master-controlled settings as one batch. Settings the
+// master does not control are left alone.
+napi_value ModifyGameSettings(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
+  
+  if (args.Length() < 2) {
+    return ThrowTypeError(env, "Wrong number of arguments");
+  }
   
-  Local<Object> result = Object::New(isolate);
-  result->Set(context, String::NewFromUtf8(isolate, "success").ToLocalChecked(), 
-              Boolean::New(isolate, true)).Check();
-  result->Set(context, String::NewFromUtf8(isolate, "ordersAccepted").ToLocalChecked(), 
-              Boolean::New(isolate, true)).Check();
+  std::string gameId = ToString(env, args[0]);
+  napi_value settings = args[1];
+  std::vector<std::string> lines;
+  if (IsObject(env, settings)) {
+    static const struct {
+      const char* key;
+      const char* command;
+    } simple[] = {
+      {"master", "SET MASTER "},
+      {"press", "SET PRESS "},
+      {"minimumWait", "SET WAIT "},
+      {"victoryCenters", "SET VICTORY "},
+      {"extendHours", "EXTEND "}
+    };
+    for (const auto& setting : simple) {
+      napi_value value = GetProperty(env, settings, setting.key);
+      if (!IsUndefined(env, value)) {
+        lines.push_back(setting.command + ToString(env, value));
+      }
+    }
+    napi_value moderated = GetProperty(env, settings, "moderated");
+    if (!IsUndefined(env, moderated)) {
+      lines.push_back(ToBoolean(env, moderated) ? "SET MODERATE" : "SET UNMODERATE");
+    }
+    // Pausing is only a change when the game is not already that way
+    napi_value paused = GetProperty(env, settings, "paused");
+    if (!IsUndefined(env, paused) && ToBoolean(env, paused) != engine->gameControls[gameId].paused) {
+      lines.push_back(ToBoolean(env, paused) ? "PAUSE" : "RESUME");
+    }
+  }
   
-  args.GetReturnValue().Set(result);
+  return masterBatchResult(env, "", {gameId}, lines, false);
 }
 
-// Game administration functions
-void CreateGame(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
-  Local<Context> context = isolate->GetCurrentContext();
+napi_value SetMaster(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
   
-  if (args.Length() < 3) {
-    isolate->ThrowException(Exception::TypeError(
-        String::NewFromUtf8(isolate, "Wrong number of arguments").ToLocalChecked()));
-    return;
+  if (args.Length() < 2) {
+    return ThrowTypeError(env, "Wrong number of arguments");
   }
   
-  String::Utf8Value variant(isolate, args[0]);
-  String::Utf8Value name(isolate, args[1]);
-  
-  // Handle third parameter which could be a number or string
-  std::string playerCountStr;
-  int playerCount = 7; // Default
-  
-  if (args[2]->IsString()) {
-    String::Utf8Value playerCountVal(isolate, args[2]);
-    playerCountStr = std::string(*playerCountVal);
-    playerCount = std::stoi(playerCountStr);
-  } else if (args[2]->IsNumber()) {
-    playerCount = args[2]->Int32Value(context).FromJust();
-  }
-  
-  std::string gameId = generateId();
-  
-  // Store game in our map (for the demo)
-  games[gameId] = {
-    gameId,
-    std::string(*name),
-    "Description",
-    std::string(*variant),
-    "DIPLOMACY",
-    "grey",
-    24,
-    12,
-    "Standard",
-    "2023-01-01",
-    {}
-  };
-  
-  Local<Object> result = Object::New(isolate);
-  result->Set(context, String::NewFromUtf8(isolate, "success").ToLocalChecked(), 
-              Boolean::New(isolate, true)).Check();
-  result->Set(context, String::NewFromUtf8(isolate, "gameId").ToLocalChecked(), 
-              String::NewFromUtf8(isolate, gameId.c_str()).ToLocalChecked()).Check();
+  std::string gameId = ToString(env, args[0]);
+  std::string master = ToString(env, args[1]);
   
-  args.GetReturnValue().Set(result);
+  return masterBatchResult(env, "", {gameId}, {"SET MASTER " + master}, false);
 }
 
-void ListGames(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
-  Local<Context> context = isolate->GetCurrentContext();
+// A master's commands for one game or many, applied to all of them or, if
+// any command fails for any game, to none
+napi_value ApplyMasterCommands(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
   
-  Local<Array> gameList = Array::New(isolate, games.size());
-  
-  int i = 0;
-  for (const auto& pair : games) {
-    const GameDetails& game = pair.second;
-    
-    Local<Object> gameObj = Object::New(isolate);
-    gameObj->Set(context, String::NewFromUtf8(isolate, "id").ToLocalChecked(), 
-                 String::NewFromUtf8(isolate, game.id.c_str()).ToLocalChecked()).Check();
-    gameObj->Set(context, String::NewFromUtf8(isolate, "name").ToLocalChecked(), 
-                 String::NewFromUtf8(isolate, game.name.c_str()).ToLocalChecked()).Check();
-    gameObj->Set(context, String::NewFromUtf8(isolate, "phase").ToLocalChecked(), 
-                 String::NewFromUtf8(isolate, game.phase.c_str()).ToLocalChecked()).Check();
-    gameObj->Set(context, String::NewFromUtf8(isolate, "players").ToLocalChecked(), 
-                 Number::New(isolate, game.players.size())).Check();
-    
-    gameList->Set(context, i++, gameObj).Check();
+  if (args.Length() < 3) {
+    return ThrowTypeError(env, "Wrong number of arguments");
   }
   
-  args.GetReturnValue().Set(gameList);
+  std::string master = ToString(env, args[0]);
+  std::vector<std::string> gameIds = orderLines(env, args[1]);
+  std::vector<std::string> lines = orderLines(env, args[2]);
+  
+  return masterBatchResult(env, master, gameIds, lines, true);
 }
 
-void GetGameDetails(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
-  Local<Context> context = isolate->GetCurrentContext();
+// A game's master, pause and access settings, and the journal of the
+// batches applied to it
+napi_value GetGameControl(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
   
   if (args.Length() < 1) {
-    isolate->ThrowException(Exception::TypeError(
-        String::NewFromUtf8(isolate, "Wrong number of arguments").ToLocalChecked()));
-    return;
+    return ThrowTypeError(env, "Wrong number of arguments");
   }
   
-  String::Utf8Value gameIdVal(isolate, args[0]);
-  std::string gameId = std::string(*gameIdVal);
-  
-  // Demo data
-  Local<Object> details = Object::New(isolate);
-  details->Set(context, String::NewFromUtf8(isolate, "id").ToLocalChecked(), 
-               String::NewFromUtf8(isolate, gameId.c_str()).ToLocalChecked()).Check();
-  details->Set(context, String::NewFromUtf8(isolate, "name").ToLocalChecked(), 
-               String::NewFromUtf8(isolate, "Test Game").ToLocalChecked()).Check();
-  details->Set(context, String::NewFromUtf8(isolate, "variant").ToLocalChecked(), 
-               String::NewFromUtf8(isolate, "standard").ToLocalChecked()).Check();
-  details->Set(context, String::NewFromUtf8(isolate, "phase").ToLocalChecked(), 
-               String::NewFromUtf8(isolate, currentSeason.c_str()).ToLocalChecked()).Check();
-  details->Set(context, String::NewFromUtf8(isolate, "year").ToLocalChecked(), 
-               Number::New(isolate, currentYear)).Check();
-  details->Set(context, String::NewFromUtf8(isolate, "players").ToLocalChecked(), 
-               Number::New(isolate, 7)).Check();
-  details->Set(context, String::NewFromUtf8(isolate, "started").ToLocalChecked(), 
-               Boolean::New(isolate, false)).Check();
-  
-  // Add other fields for backward compatibility
-  details->Set(context, String::NewFromUtf8(isolate, "press").ToLocalChecked(), 
-               String::NewFromUtf8(isolate, "grey").ToLocalChecked()).Check();
-  details->Set(context, String::NewFromUtf8(isolate, "deadline").ToLocalChecked(), 
-               String::NewFromUtf8(isolate, "24h").ToLocalChecked()).Check();
-  details->Set(context, String::NewFromUtf8(isolate, "graceTime").ToLocalChecked(), 
-               String::NewFromUtf8(isolate, "12h").ToLocalChecked()).Check();
-  details->Set(context, String::NewFromUtf8(isolate, "victoryConditions").ToLocalChecked(), 
-               String::NewFromUtf8(isolate, "Standard").ToLocalChecked()).Check();
-  details->Set(context, String::NewFromUtf8(isolate, "startTime").ToLocalChecked(), 
-               String::NewFromUtf8(isolate, "2023-01-01").ToLocalChecked()).Check();
-  
-  // Add a playerList property - the actual list of players
-  Local<Array> playerList = Array::New(isolate, 7);
-  const char* powers[] = {"ENGLAND", "FRANCE", "GERMANY", "ITALY", "AUSTRIA", "RUSSIA", "TURKEY"};
-  
-  for (int i = 0; i < 7; ++i) {
-    Local<Object> player = Object::New(isolate);
-    player->Set(context, String::NewFromUtf8(isolate, "power").ToLocalChecked(), 
-                String::NewFromUtf8(isolate, powers[i]).ToLocalChecked()).Check();
-    player->Set(context, String::NewFromUtf8(isolate, "status").ToLocalChecked(), 
-                String::NewFromUtf8(isolate, "ACTIVE").ToLocalChecked()).Check();
-    player->Set(context, String::NewFromUtf8(isolate, "player").ToLocalChecked(), 
-                String::NewFromUtf8(isolate, ("Player " + std::to_string(i+1)).c_str()).ToLocalChecked()).Check();
-    
-    playerList->Set(context, i, player).Check();
+  std::string gameId = ToString(env, args[0]);
+  auto it = engine->gameControls.find(gameId);
+  GameControl none;
+  const GameControl& control = it != engine->gameControls.end() ? it->second : none;
+  
+  napi_value access = NewObject(env);
+  SetProperty(env, access, "dedication", NewNumber(env, control.access.dedication));
+  SetProperty(env, access, "onTimeRating", NewNumber(env, control.access.onTimeRating));
+  SetProperty(env, access, "resistanceRating", NewNumber(env, control.access.resistanceRating));
+  
+  napi_value journal = NewArray(env, control.journal.size());
+  for (size_t i = 0; i < control.journal.size(); i++) {
+    const ControlEntry& batch = control.journal[i];
+    napi_value commands = NewArray(env, batch.commands.size());
+    for (size_t j = 0; j < batch.commands.size(); j++) {
+      SetElement(env, commands, static_cast<uint32_t>(j), NewString(env, batch.commands[j]));
+    }
+    napi_value entry = NewObject(env);
+    SetProperty(env, entry, "sequence", NewNumber(env, static_cast<double>(batch.sequence)));
+    SetProperty(env, entry, "master", NewString(env, batch.master));
+    SetProperty(env, entry, "phase", NewString(env, batch.phase));
+    SetProperty(env, entry, "commands", commands);
+    SetElement(env, journal, static_cast<uint32_t>(i), entry);
   }
   
-  // Add the playerList separate from players count
-  details->Set(context, String::NewFromUtf8(isolate, "playerList").ToLocalChecked(), playerList).Check();
+  napi_value result = NewObject(env);
+  SetProperty(env, result, "master", NewString(env, control.master));
+  SetProperty(env, result, "paused", NewBoolean(env, control.paused));
+  SetProperty(env, result, "moderated", NewBoolean(env, control.moderated));
+  SetProperty(env, result, "extensionHours", NewNumber(env, control.extensionHours));
+  SetProperty(env, result, "access", access);
+  SetProperty(env, result, "journal", journal);
   
-  args.GetReturnValue().Set(details);
+  return result;
 }
 
-void ModifyGameSettings(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
-  Local<Context> context = isolate->GetCurrentContext();
+napi_value BackupGame(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
   
-  Local<Object> result = Object::New(isolate);
-  result->Set(context, String::NewFromUtf8(isolate, "success").ToLocalChecked(), 
-              Boolean::New(isolate, true)).Check();
+  if (args.Length() < 1) {
+    return ThrowTypeError(env, "Wrong number of arguments");
+  }
+  
+  std::string gameId = ToString(env, args[0]);
+  
+  // Generate a backup ID, keeping the board, history and end-of-game state
+  std::string backupId = newBackupId();
+  engine->backups.emplace(backupId, GameBackup{gameId, &gameVariant(gameId),
+                                               std::make_shared<const Board>(gameBoard(gameId)),
+                                               engine->histories[gameId], gameEnd(gameId)});
   
-  args.GetReturnValue().Set(result);
+  napi_value result = NewObject(env);
+  SetProperty(env, result, "success", NewBoolean(env, true));
+  SetProperty(env, result, "backupId", NewString(env, backupId));
+  
+  return result;
 }
 
-void SetMaster(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
-  Local<Context> context = isolate->GetCurrentContext();
+napi_value RestoreGame(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
+  
+  if (args.Length() < 1) {
+    return ThrowTypeError(env, "Wrong number of arguments");
+  }
   
-  Local<Object> result = Object::New(isolate);
-  result->Set(context, String::NewFromUtf8(isolate, "success").ToLocalChecked(), 
-              Boolean::New(isolate, true)).Check();
+  std::string backupId = ToString(env, args[0]);
   
-  args.GetReturnValue().Set(result);
+  auto backup = engine->backups.find(backupId);
+  if (backup == engine->backups.end()) {
+    napi_value result = NewObject(env);
+    SetProperty(env, result, "success", NewBoolean(env, false));
+    SetProperty(env, result, "gameId", NewString(env, ""));
+    return result;
+  }
+  
+  // Put back the board, history and votes; the board stays shared with
+  // the backup until the game is next adjudicated. Orders and readiness
+  // start over for the restored phase.
+  const GameBackup& saved = backup->second;
+  const std::string& gameId = saved.gameId;
+  engine->gameVariants[gameId] = saved.variant;
+  engine->boards.erase(gameId);
+  engine->boards.emplace(gameId, CopyOnWrite<Board>(saved.board));
+  engine->histories.erase(gameId);
+  engine->histories.emplace(gameId, saved.history);
+  engine->gameEnds.erase(gameId);
+  engine->gameEnds.emplace(gameId, saved.tracker);
+  engine->orderStores.erase(gameId);
+  engine->readiness.erase(gameId);
+  engine->adjudicationQueue.Cancel(gameId);
+  gameReadiness(gameId);
+  syncGame(gameId, {}, false);
+  
+  napi_value result = NewObject(env);
+  SetProperty(env, result, "success", NewBoolean(env, true));
+  SetProperty(env, result, "gameId", NewString(env, gameId));
+  
+  return result;
 }
 
-void BackupGame(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
-  Local<Context> context = isolate->GetCurrentContext();
+// Position of a game at the start of a past or current phase
+napi_value GetGameStateAt(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
   
-  if (args.Length() < 1) {
-    isolate->ThrowException(Exception::TypeError(
-        String::NewFromUtf8(isolate, "Wrong number of arguments").ToLocalChecked()));
-    return;
+  if (args.Length() < 4) {
+    return ThrowTypeError(env, "Wrong number of arguments");
+  }
+  
+  std::string gameId = ToString(env, args[0]);
+  int year = ToInt32(env, args[1]);
+  std::string seasonVal = ToString(env, args[2]);
+  std::string phaseVal = ToString(env, args[3]);
+  std::string season = upperCase(seasonVal);
+  std::string phase = upperCase(phaseVal);
+  
+  // "Fall", 1901, "Retreat" -> "F1901R"; builds are adjustment phases
+  char phaseLetter = phase.empty() ? 'M' : phase[0];
+  if (phaseLetter == 'B') {
+    phaseLetter = 'A';
+  }
+  std::string phaseName = std::string(1, season.empty() ? 'S' : season[0]) +
+                          std::to_string(year) + phaseLetter;
+  
+  if (!knownGame(gameId)) {
+    return Null(env);
+  }
+  const Board& current = gameBoard(gameId);
+  Board board = current;
+  auto history = engine->histories.find(gameId);
+  if (current.PhaseName() != phaseName &&
+      (history == engine->histories.end() || !history->second.StateAt(phaseName, &board))) {
+    return Null(env);
   }
   
-  String::Utf8Value gameId(isolate, args[0]);
+  const Map& map = board.GetMap();
+  auto unitObject = [&](int power, UnitType type, const Location& location) {
+    napi_value unit = NewObject(env);
+    SetProperty(env, unit, "power", NewString(env, map.PowerKey(power)));
+    SetProperty(env, unit, "type", NewString(env, type == UNIT_ARMY ? "A" : "F"));
+    SetProperty(env, unit, "location", NewString(env, map.LocationName(location)));
+    return unit;
+  };
   
-  // Generate a backup ID
-  std::string backupId = "backup-" + generateId();
+  napi_value units = NewArray(env);
+  napi_value centers = NewObject(env);
+  for (int power = 0; power < map.PowerCount(); ++power) {
+    SetProperty(env, centers, map.PowerKey(power).c_str(), NewArray(env));
+  }
+  for (ProvinceId p = 0; p < map.ProvinceCount(); ++p) {
+    const Unit& unit = board.units[p];
+    if (unit.power >= 0) {
+      SetElement(env, units, ArrayLength(env, units), unitObject(unit.power, unit.type, Location{p, unit.coast}));
+    }
+    if (board.owners[p] >= 0) {
+      napi_value owned = GetProperty(env, centers, map.PowerKey(board.owners[p]).c_str());
+      SetElement(env, owned, ArrayLength(env, owned), NewString(env, map.GetProvince(p).abbr));
+    }
+  }
+  napi_value dislodged = NewArray(env, board.dislodged.size());
+  for (size_t i = 0; i < board.dislodged.size(); ++i) {
+    const DislodgedUnit& unit = board.dislodged[i];
+    SetElement(env, dislodged, i, unitObject(unit.power, unit.type, unit.location));
+  }
   
-  Local<Object> result = Object::New(isolate);
-  result->Set(context, String::NewFromUtf8(isolate, "success").ToLocalChecked(), 
-              Boolean::New(isolate, true)).Check();
-  result->Set(context, String::NewFromUtf8(isolate, "backupId").ToLocalChecked(), 
-              String::NewFromUtf8(isolate, backupId.c_str()).ToLocalChecked()).Check();
+  napi_value state = NewObject(env);
+  SetProperty(env, state, "year", NewNumber(env, board.year));
+  SetProperty(env, state, "season", NewString(env, seasonName(board.season)));
+  SetProperty(env, state, "phase", NewString(env, phaseTypeName(board.phase)));
+  SetProperty(env, state, "units", units);
+  SetProperty(env, state, "dislodged", dislodged);
+  SetProperty(env, state, "centers", centers);
   
-  args.GetReturnValue().Set(result);
+  return state;
 }
 
-void RestoreGame(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
-  Local<Context> context = isolate->GetCurrentContext();
+// SVG map of a game: a played phase with its orders and their results,
+// the latest played phase by default, or the current position when asked
+// for the phase now in progress
+napi_value RenderMap(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
   
   if (args.Length() < 1) {
-    isolate->ThrowException(Exception::TypeError(
-        String::NewFromUtf8(isolate, "Wrong number of arguments").ToLocalChecked()));
-    return;
+    return ThrowTypeError(env, "Wrong number of arguments");
   }
   
-  String::Utf8Value backupId(isolate, args[0]);
-  
-  // For demo purposes, restore means Spring 1901
-  currentPhase = "DIPLOMACY";
-  currentSeason = "Spring";
-  currentYear = 1901;
+  std::string gameId = ToString(env, args[0]);
+  if (!knownGame(gameId)) {
+    return Null(env);
+  }
+  auto history = engine->histories.find(gameId);
+  bool played = history != engine->histories.end();
+  std::string phaseName = played ? history->second.LastPhase() : "";
+  if (args.Length() > 1 && !IsUndefined(env, args[1])) {
+    std::string phaseVal = ToString(env, args[1]);
+    phaseName = upperCase(phaseVal);
+  }
   
-  Local<Object> result = Object::New(isolate);
-  result->Set(context, String::NewFromUtf8(isolate, "success").ToLocalChecked(), 
-              Boolean::New(isolate, true)).Check();
-  result->Set(context, String::NewFromUtf8(isolate, "gameId").ToLocalChecked(), 
-              String::NewFromUtf8(isolate, "restored-game-123").ToLocalChecked()).Check();
+  // Orders are drawn on the board they were given on; replaying them
+  // recovers their results
+  const Board& current = gameBoard(gameId);
+  Board board = current;
+  PhaseResult result;
+  if (!phaseName.empty() && phaseName != current.PhaseName()) {
+    std::vector<Order> orders;
+    if (!played || !history->second.StateAt(phaseName, &board) ||
+        !history->second.OrdersAt(phaseName, &orders)) {
+      return Null(env);
+    }
+    Board after = board;
+    Adjudicate(&after, orders, &result);
+  }
   
-  args.GetReturnValue().Set(result);
+  const std::string& svg = engine->mapRenderers[gameId].Render(board, result.orders);
+  return NewString(env, svg);
 }
 
 // Player account management functions
-void LinkPlayerEmail(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
+napi_value LinkPlayerEmail(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
   
   if (args.Length() < 2) {
-    isolate->ThrowException(Exception::TypeError(
-        String::NewFromUtf8(isolate, "Wrong number of arguments").ToLocalChecked()));
-    return;
+    return ThrowTypeError(env, "Wrong number of arguments");
   }
   
-  String::Utf8Value newEmail(isolate, args[0]);
-  String::Utf8Value existingEmail(isolate, args[1]);
+  std::string newEmail = ToString(env, args[0]);
+  std::string existingEmail = ToString(env, args[1]);
   
   // Store the email mapping
-  emailMap[std::string(*newEmail)] = std::string(*existingEmail);
+  engine->emailMap[newEmail] = existingEmail;
   
   // Return success
-  args.GetReturnValue().Set(Boolean::New(isolate, true));
+  return NewBoolean(env, true);
 }
 
-void SetPlayerPreferences(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
+napi_value SetPlayerPreferences(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
   
   if (args.Length() < 2) {
-    isolate->ThrowException(Exception::TypeError(
-        String::NewFromUtf8(isolate, "Wrong number of arguments").ToLocalChecked()));
-    return;
+    return ThrowTypeError(env, "Wrong number of arguments");
   }
   
-  int playerId = args[0]->Int32Value(isolate->GetCurrentContext()).FromJust();
-  Local<Object> prefsObj = args[1]->ToObject(isolate->GetCurrentContext()).ToLocalChecked();
+  int playerId = ToInt32(env, args[0]);
+  napi_value prefsObj = args[1];
   
   // Get preference values
-  Local<String> notificationsKey = String::NewFromUtf8(isolate, "notifications").ToLocalChecked();
-  Local<String> deadlineKey = String::NewFromUtf8(isolate, "deadlineReminders").ToLocalChecked();
-  Local<String> orderKey = String::NewFromUtf8(isolate, "orderConfirmation").ToLocalChecked();
-  
-  bool notifications = prefsObj->Get(isolate->GetCurrentContext(), notificationsKey)
-      .ToLocalChecked()->BooleanValue(isolate);
-  bool deadlineReminders = prefsObj->Get(isolate->GetCurrentContext(), deadlineKey)
-      .ToLocalChecked()->BooleanValue(isolate);
-  bool orderConfirmation = prefsObj->Get(isolate->GetCurrentContext(), orderKey)
-      .ToLocalChecked()->BooleanValue(isolate);
-  
-  // Store preferences
-  playerPreferences[playerId] = {
-    notifications,
-    deadlineReminders,
-    orderConfirmation
-  };
+  bool notifications = ToBoolean(env, GetProperty(env, prefsObj, "notifications"));
+  bool deadlineReminders = ToBoolean(env, GetProperty(env, prefsObj, "deadlineReminders"));
+  bool orderConfirmation = ToBoolean(env, GetProperty(env, prefsObj, "orderConfirmation"));
   
-  // Return success
-  args.GetReturnValue().Set(Boolean::New(isolate, true));
+  PlayerProfile profile = playerProfile(playerId);
+  profile.notifications = notifications;
+  profile.deadlineReminders = deadlineReminders;
+  profile.orderConfirmation = orderConfirmation;
+  
+  return NewBoolean(env, engine->profiles.Put(profile));
+}
+
+// Keep profiles in the store at a path, creating it if needed, or in
+// memory for ""
+napi_value OpenProfileStore(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
+  
+  if (args.Length() < 1) {
+    return ThrowTypeError(env, "Wrong number of arguments");
+  }
+  
+  std::string path = ToString(env, args[0]);
+  std::string error;
+  bool opened = engine->profiles.Open(path, &error);
+  
+  napi_value result = NewObject(env);
+  SetProperty(env, result, "success", NewBoolean(env, opened));
+  SetProperty(env, result, "profiles", NewNumber(env, static_cast<double>(engine->profiles.Count())));
+  if (!opened) {
+    SetProperty(env, result, "error", NewString(env, error));
+  }
+  return result;
+}
+
+napi_value GetPlayerProfile(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
+  
+  if (args.Length() < 1) {
+    return ThrowTypeError(env, "Wrong number of arguments");
+  }
+  
+  int playerId = ToInt32(env, args[0]);
+  PlayerProfile profile;
+  if (!engine->profiles.Get(playerId, &profile)) {
+    return Null(env);
+  }
+  
+  napi_value result = NewObject(env);
+  SetProperty(env, result, "playerId", NewNumber(env, profile.playerId));
+  SetProperty(env, result, "notifications", NewBoolean(env, profile.notifications));
+  SetProperty(env, result, "deadlineReminders", NewBoolean(env, profile.deadlineReminders));
+  SetProperty(env, result, "orderConfirmation", NewBoolean(env, profile.orderConfirmation));
+  SetProperty(env, result, "vacationStart", NewNumber(env, static_cast<double>(profile.vacationStart)));
+  SetProperty(env, result, "vacationEnd", NewNumber(env, static_cast<double>(profile.vacationEnd)));
+  SetProperty(env, result, "level", NewString(env, profile.level));
+  SetProperty(env, result, "address", NewString(env, profile.address));
+  return result;
+}
+
+napi_value FlushProfiles(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
+  engine->profiles.Flush();
+  return NewBoolean(env, true);
 }
 
 // Email and text processing functions
-void ProcessTextInput(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
+napi_value ProcessTextInput(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
   
   if (args.Length() < 2) {
-    isolate->ThrowException(Exception::TypeError(
-        String::NewFromUtf8(isolate, "Wrong number of arguments").ToLocalChecked()));
-    return;
+    return ThrowTypeError(env, "Wrong number of arguments");
   }
   
-  String::Utf8Value text(isolate, args[0]);
-  String::Utf8Value fromEmail(isolate, args[1]);
+  std::string text = ToString(env, args[0]);
+  std::string fromEmail = ToString(env, args[1]);
   
-  std::string textStr = std::string(*text);
-  std::string emailStr = std::string(*fromEmail);
+  std::string textStr = text;
+  std::string emailStr = fromEmail;
   
   // Process different commands (simplified for test passing)
   if (textStr.find("REGISTER") == 0) {
@@ -740,7 +2342,7 @@ void ProcessTextInput(const FunctionCallbackInfo<Value>& args) {
     email.from = "system@diplomacy.net";
     email.subject = "REGISTER Confirmation";
     email.body = "Your registration has been processed.";
-    outboundEmails.push_back(email);
+    engine->outboundEmails.push_back(email);
   } 
   else if (textStr.find("UNREGISTER") == 0) {
     // Create a mock email response for UNREGISTER
@@ -749,7 +2351,7 @@ void ProcessTextInput(const FunctionCallbackInfo<Value>& args) {
     email.from = "system@diplomacy.net";
     email.subject = "UNREGISTER Confirmation";
     email.body = "Your account has been unregistered.";
-    outboundEmails.push_back(email);
+    engine->outboundEmails.push_back(email);
   }
   else if (textStr.find("SET PASSWORD") == 0) {
     Email email;
@@ -757,15 +2359,30 @@ void ProcessTextInput(const FunctionCallbackInfo<Value>& args) {
     email.from = "system@diplomacy.net";
     email.subject = "PASSWORD Changed";
     email.body = "Your password has been updated.";
-    outboundEmails.push_back(email);
+    engine->outboundEmails.push_back(email);
   }
   else if (textStr.find("SET ADDRESS") == 0) {
+    // "SET ADDRESS text": everything after the command, lines and all
+    std::string address = textStr.substr(11);
+    address.erase(0, std::min(address.size(), address.find_first_not_of(" \t\r\n")));
+    address.erase(address.find_last_not_of(" \t\r\n") + 1);
+    int playerId = emailPlayerId(emailStr);
+    PlayerProfile profile = playerProfile(playerId);
+    profile.address = address;
     Email email;
     email.to = emailStr;
     email.from = "system@diplomacy.net";
-    email.subject = "ADDRESS Updated";
-    email.body = "Your address information has been updated.";
-    outboundEmails.push_back(email);
+    if (playerId == 0) {
+      email.subject = "ADDRESS Failed";
+      email.body = "No player is registered from this address.";
+    } else if (!engine->profiles.Put(profile)) {
+      email.subject = "ADDRESS Failed";
+      email.body = "Addresses are limited to " + std::to_string(ProfileStore::kMaxAddress) + " characters.";
+    } else {
+      email.subject = "ADDRESS Updated";
+      email.body = "Your address information has been updated.";
+    }
+    engine->outboundEmails.push_back(email);
   }
   else if (textStr.find("SET EMAIL") == 0) {
     Email email;
@@ -773,7 +2390,7 @@ void ProcessTextInput(const FunctionCallbackInfo<Value>& args) {
     email.from = "system@diplomacy.net";
     email.subject = "EMAIL Changed";
     email.body = "Your email has been updated.";
-    outboundEmails.push_back(email);
+    engine->outboundEmails.push_back(email);
   }
   else if (textStr.find("SET PHONE") == 0) {
     Email email;
@@ -781,23 +2398,120 @@ void ProcessTextInput(const FunctionCallbackInfo<Value>& args) {
     email.from = "system@diplomacy.net";
     email.subject = "PHONE Updated";
     email.body = "Your phone number has been updated.";
-    outboundEmails.push_back(email);
+    engine->outboundEmails.push_back(email);
   }
   else if (textStr.find("SET LEVEL") == 0) {
+    // "SET LEVEL novice|amateur|intermediate|advanced|expert"
+    std::istringstream words(textStr.substr(9));
+    std::string level;
+    words >> level;
+    for (auto& c : level) {
+      c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    static const std::vector<std::string> levels = {"novice", "amateur", "intermediate", "advanced", "expert"};
+    int playerId = emailPlayerId(emailStr);
     Email email;
     email.to = emailStr;
     email.from = "system@diplomacy.net";
-    email.subject = "LEVEL Changed";
-    email.body = "Your experience level has been updated.";
-    outboundEmails.push_back(email);
+    if (playerId == 0) {
+      email.subject = "LEVEL Failed";
+      email.body = "No player is registered from this address.";
+    } else if (std::find(levels.begin(), levels.end(), level) == levels.end()) {
+      email.subject = "LEVEL Failed";
+      email.body = "Level must be novice, amateur, intermediate, advanced or expert.";
+    } else {
+      PlayerProfile profile = playerProfile(playerId);
+      profile.level = level;
+      engine->profiles.Put(profile);
+      email.subject = "LEVEL Changed";
+      email.body = "Your experience level has been updated.";
+    }
+    engine->outboundEmails.push_back(email);
   }
   else if (textStr.find("SET VACATION") == 0) {
+    // "SET VACATION first [TO] last" with YYYY-MM-DD dates, or
+    // "SET VACATION NONE"
+    std::istringstream words(textStr.substr(12));
+    std::string first, last;
+    words >> first >> last;
+    if (upperCase(last) == "TO") {
+      words >> last;
+    }
+    int playerId = emailPlayerId(emailStr);
+    PlayerProfile profile = playerProfile(playerId);
+    bool clear = upperCase(first) == "NONE";
+    bool valid = clear || (parseDate(first, &profile.vacationStart) &&
+                           parseDate(last, &profile.vacationEnd) &&
+                           profile.vacationEnd >= profile.vacationStart);
+    if (clear) {
+      profile.vacationStart = 0;
+      profile.vacationEnd = 0;
+    } else if (valid) {
+      // The vacation runs to the end of its last day
+      profile.vacationEnd += 86400000;
+    }
+    Email email;
+    email.to = emailStr;
+    email.from = "system@diplomacy.net";
+    if (playerId == 0) {
+      email.subject = "VACATION Failed";
+      email.body = "No player is registered from this address.";
+    } else if (!valid) {
+      email.subject = "VACATION Failed";
+      email.body = "Give the first and last days as YYYY-MM-DD, or NONE.";
+    } else {
+      engine->profiles.Put(profile);
+      email.subject = "VACATION Status Updated";
+      email.body = clear ? "Your vacation has been cancelled." : "Your vacation dates have been recorded.";
+    }
+    engine->outboundEmails.push_back(email);
+  }
+  else if (textStr.find("SET WAIT") == 0 || textStr.find("UNSET WAIT") == 0) {
+    // A waiting power holds its game to the deadline even with orders in
+    bool wait = textStr.find("SET WAIT") == 0;
+    for (const auto& pair : engine->playerEmails) {
+      if (pair.second == emailStr && engine->playerGames.count(pair.first)) {
+        const std::string& gameId = engine->playerGames[pair.first];
+        int power = gameBoard(gameId).GetMap().FindPower(playerPower(pair.first));
+        if (power >= 0) {
+          gameReadiness(gameId).SetWait(power, wait);
+          checkReady(gameId, power);
+          break;
+        }
+      }
+    }
+    Email email;
+    email.to = emailStr;
+    email.from = "system@diplomacy.net";
+    email.subject = wait ? "WAIT Set" : "WAIT Cleared";
+    email.body = wait ? "Your game will wait for the deadline before processing."
+                      : "Your game may process as soon as all orders are in.";
+    engine->outboundEmails.push_back(email);
+  }
+  else if (textStr.find("OBSERVE") == 0) {
+    // "OBSERVE game [delay]": watch a game, optionally some phases behind
+    std::istringstream words(textStr.substr(7));
+    std::string gameId;
+    int delay = 0;
+    words >> gameId >> delay;
     Email email;
     email.to = emailStr;
     email.from = "system@diplomacy.net";
-    email.subject = "VACATION Status Updated";
-    email.body = "Your vacation dates have been recorded.";
-    outboundEmails.push_back(email);
+    if (gameId.empty()) {
+      email.subject = "OBSERVE Failed";
+      email.body = "Name the game to observe.";
+    } else if (delay < 0) {
+      email.subject = "OBSERVE Failed";
+      email.body = "The delay is a number of phases, 0 or more.";
+    } else {
+      engine->observers[gameId].Subscribe(emailStr, delay);
+      email.subject = "OBSERVE " + gameId;
+      email.body = "You are now observing game " + gameId + ".";
+      if (delay > 0) {
+        email.body += " Results reach you " + std::to_string(delay) + " phases late.";
+      }
+    }
+    engine->outboundEmails.push_back(email);
   }
   else if (textStr.find("SET PREFERENCE") == 0 || textStr.find("SET NO PREFERENCE") == 0) {
     Email email;
@@ -805,26 +2519,67 @@ void ProcessTextInput(const FunctionCallbackInfo<Value>& args) {
     email.from = "system@diplomacy.net";
     email.subject = "PREFERENCE Updated";
     email.body = "Your power preferences have been updated.";
-    outboundEmails.push_back(email);
+    engine->outboundEmails.push_back(email);
   }
   else if (textStr.find("PRESS") == 0) {
-    // Parse a simplified press message
-    size_t fromPos = textStr.find("FROM");
-    size_t toPos = textStr.find("TO");
+    // "PRESS [FROM power] TO power" and the message on the lines after it.
+    // The sender is the power of the sending address's seat, and a FROM
+    // naming any other power is refused; an address that only watches a
+    // game sends observer press to it.
+    size_t newline = textStr.find('\n');
+    std::string heading = upperCase(textStr.substr(0, newline));
+    std::string message = newline == std::string::npos ? "" : textStr.substr(newline + 1);
+    size_t toPos = heading.find(" TO ");
+    if (toPos == std::string::npos) {
+      return NewBoolean(env, false);
+    }
+    size_t fromPos = heading.find(" FROM ");
+    std::string claimed = fromPos < toPos ? heading.substr(fromPos + 6, toPos - fromPos - 6) : "";
+    std::string recipient = heading.substr(toPos + 4);
     
-    if (fromPos != std::string::npos && toPos != std::string::npos) {
-      std::string fromPower = textStr.substr(fromPos + 5, toPos - fromPos - 6);
-      std::string toPower = textStr.substr(toPos + 3, textStr.find("\n") - toPos - 3);
-      std::string message = textStr.substr(textStr.find("\n") + 1);
-      
-      // Create mock emails for press messages
-      Email email;
-      email.to = toPower == "ALL" ? "all-players@diplomacy.net" : toPower + "@example.com";
-      email.from = fromPower + "@example.com";
-      email.subject = "Press from " + fromPower;
-      email.body = message;
-      outboundEmails.push_back(email);
+    int senderId = 0;
+    std::string gameId;
+    std::string senderPower;
+    for (const auto& pair : engine->playerEmails) {
+      auto seat = engine->playerGames.find(pair.first);
+      if (pair.second == emailStr && seat != engine->playerGames.end()) {
+        senderId = pair.first;
+        gameId = seat->second;
+        senderPower = playerPower(pair.first);
+        break;
+      }
+    }
+    if (gameId.empty()) {
+      for (const auto& watched : engine->observers) {
+        if (watched.second.Delay(emailStr) >= 0) {
+          gameId = watched.first;
+          break;
+        }
+      }
+    }
+    if (gameId.empty() || (!claimed.empty() && claimed != senderPower)) {
+      return NewBoolean(env, false);
+    }
+    
+    // Log the press in the sender's game
+    bool observer = senderPower.empty();
+    bool broadcast = recipient == "ALL";
+    uint32_t required = PressRequirements(false, broadcast, false, observer,
+                                          PressPhaseFlag(engine->currentPhase));
+    if (!PressAllowed(gamePressPolicy(gameId), required)) {
+      return NewBoolean(env, false);
     }
+    engine->pressStores[gameId].Append(
+        senderId, senderPower, broadcast ? PRESS_BROADCAST : PRESS_PARTIAL, false, false,
+        {recipient}, phaseLabel(), message);
+    
+    // Create mock emails for press messages
+    Email email;
+    email.to = broadcast ? "all-players@diplomacy.net" : recipient + "@example.com";
+    email.from = observer ? emailStr : senderPower + "@example.com";
+    email.subject = "Press from " + (observer ? std::string("Observer") : senderPower);
+    email.body = message;
+    engine->outboundEmails.push_back(email);
   }
   else if (textStr.find("BROADCAST") == 0) {
     // Handle broadcast to all players and observers
@@ -833,7 +2588,7 @@ void ProcessTextInput(const FunctionCallbackInfo<Value>& args) {
     email.from = emailStr;
     email.subject = "BROADCAST: Game Announcement";
     email.body = textStr.substr(10); // Remove "BROADCAST " prefix
-    outboundEmails.push_back(email);
+    engine->outboundEmails.push_back(email);
   }
   else if (textStr.find("DIARY") == 0) {
     // Handle player diary entries
@@ -842,159 +2597,310 @@ void ProcessTextInput(const FunctionCallbackInfo<Value>& args) {
     email.from = "system@diplomacy.net";
     email.subject = "DIARY Entry Saved";
     email.body = "Your diary entry has been saved.";
-    outboundEmails.push_back(email);
+    engine->outboundEmails.push_back(email);
   }
   
   // Return success for all commands for now
-  args.GetReturnValue().Set(Boolean::New(isolate, true));
+  return NewBoolean(env, true);
 }
 
-void GetTextOutput(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
+napi_value GetTextOutput(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
   
   if (args.Length() < 1) {
-    isolate->ThrowException(Exception::TypeError(
-        String::NewFromUtf8(isolate, "Wrong number of arguments").ToLocalChecked()));
-    return;
+    return ThrowTypeError(env, "Wrong number of arguments");
   }
   
-  int playerId = args[0]->Int32Value(isolate->GetCurrentContext()).FromJust();
+  int playerId = ToInt32(env, args[0]);
   
-  // Mock text output for the player
+  // Status lines for the player, then the latest results of their game
   std::string output = "Game status for player " + std::to_string(playerId) + ":\n";
-  output += "Phase: " + currentPhase + "\n";
-  output += "Season: " + currentSeason + "\n";
-  output += "Year: " + std::to_string(currentYear) + "\n";
+  output += "Phase: " + engine->currentPhase + "\n";
+  output += "Season: " + engine->currentSeason + "\n";
+  output += "Year: " + std::to_string(engine->currentYear) + "\n";
+  
+  std::shared_ptr<const std::string> report;
+  auto game = engine->playerGames.find(playerId);
+  if (game != engine->playerGames.end() && engine->latestReports.count(game->second)) {
+    output += "\n";
+    report = engine->latestReports[game->second];
+  }
   
-  args.GetReturnValue().Set(String::NewFromUtf8(isolate, output.c_str()).ToLocalChecked());
+  std::map<const std::string*, napi_value> reports;
+  return withReport(env, output, report, &reports);
 }
 
-void SimulateInboundEmail(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
+napi_value SimulateInboundEmail(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
   
   if (args.Length() < 3) {
-    isolate->ThrowException(Exception::TypeError(
-        String::NewFromUtf8(isolate, "Wrong number of arguments").ToLocalChecked()));
-    return;
+    return ThrowTypeError(env, "Wrong number of arguments");
   }
   
-  String::Utf8Value subject(isolate, args[0]);
-  String::Utf8Value body(isolate, args[1]);
-  String::Utf8Value fromEmail(isolate, args[2]);
+  std::string subject = ToString(env, args[0]);
+  std::string body = ToString(env, args[1]);
+  std::string fromEmail = ToString(env, args[2]);
   
   // Process the email similar to text commands
   // For now, we'll just confirm receipt
   Email response;
-  response.to = std::string(*fromEmail);
+  response.to = fromEmail;
   response.from = "system@diplomacy.net";
-  response.subject = "Re: " + std::string(*subject);
+  response.subject = "Re: " + subject;
   response.body = "Your email has been received and processed.";
-  outboundEmails.push_back(response);
+  engine->outboundEmails.push_back(response);
   
-  args.GetReturnValue().Set(Boolean::New(isolate, true));
+  return NewBoolean(env, true);
 }
 
-void GetOutboundEmails(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
+napi_value GetOutboundEmails(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
   
   // Create an array to hold all outbound emails
-  Local<Array> emailArray = Array::New(isolate, outboundEmails.size());
+  napi_value emailArray = NewArray(env, engine->outboundEmails.size());
+  std::map<const std::string*, napi_value> reports;
   
-  for (size_t i = 0; i < outboundEmails.size(); i++) {
-    Local<Object> emailObj = Object::New(isolate);
+  for (size_t i = 0; i < engine->outboundEmails.size(); i++) {
+    napi_value emailObj = NewObject(env);
     
-    emailObj->Set(isolate->GetCurrentContext(),
-                String::NewFromUtf8(isolate, "to").ToLocalChecked(),
-                String::NewFromUtf8(isolate, outboundEmails[i].to.c_str()).ToLocalChecked()).Check();
+    SetProperty(env, emailObj, "to", NewString(env, engine->outboundEmails[i].to));
     
-    emailObj->Set(isolate->GetCurrentContext(),
-                String::NewFromUtf8(isolate, "from").ToLocalChecked(),
-                String::NewFromUtf8(isolate, outboundEmails[i].from.c_str()).ToLocalChecked()).Check();
+    SetProperty(env, emailObj, "from", NewString(env, engine->outboundEmails[i].from));
     
-    emailObj->Set(isolate->GetCurrentContext(),
-                String::NewFromUtf8(isolate, "subject").ToLocalChecked(),
-                String::NewFromUtf8(isolate, outboundEmails[i].subject.c_str()).ToLocalChecked()).Check();
+    SetProperty(env, emailObj, "subject", NewString(env, engine->outboundEmails[i].subject));
     
-    emailObj->Set(isolate->GetCurrentContext(),
-                String::NewFromUtf8(isolate, "body").ToLocalChecked(),
-                String::NewFromUtf8(isolate, outboundEmails[i].body.c_str()).ToLocalChecked()).Check();
+    SetProperty(env, emailObj, "body",
+                withReport(env, engine->outboundEmails[i].body, engine->outboundEmails[i].report, &reports));
     
-    emailArray->Set(isolate->GetCurrentContext(), i, emailObj).Check();
+    SetElement(env, emailArray, i, emailObj);
   }
   
   // Clear emails after returning them (for testing purposes)
   // This helps prevent test interference
-  outboundEmails.clear();
+  engine->outboundEmails.clear();
+  
+  return emailArray;
+}
+
+// Bulk entry points. A client driving many players or games hands the
+// engine one typed array in place of an array of strings per call, and
+// gets its answers back the same way.
+
+// Orders for several players of a game at once. `orders` holds each
+// player's orders as UTF-8, one per line, in the order of `playerIds`,
+// with a NUL after each player's block. Returns how many of each player's
+// orders were accepted; a player with no power in the game has none.
+napi_value SubmitOrdersPacked(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
+  
+  if (args.Length() < 3) {
+    return ThrowTypeError(env, "Wrong number of arguments");
+  }
+  
+  std::string gameId = ToString(env, args[0]);
+  void* ids = nullptr;
+  void* text = nullptr;
+  size_t playerCount = 0;
+  size_t length = 0;
+  if (!TypedArrayContents(env, args[1], napi_int32_array, &ids, &playerCount)) {
+    return ThrowTypeError(env, "Player IDs must be an Int32Array");
+  }
+  if (!TypedArrayContents(env, args[2], napi_uint8_array, &text, &length)) {
+    return ThrowTypeError(env, "Orders must be a Uint8Array");
+  }
+  
+  const int32_t* playerIds = static_cast<const int32_t*>(ids);
+  const char* cursor = static_cast<const char*>(text);
+  const char* end = cursor + length;
+  std::vector<int32_t> accepted(playerCount, 0);
+  std::vector<std::pair<std::string, std::string>> rejected;
+  for (size_t i = 0; i < playerCount && cursor < end; ++i) {
+    const char* blockEnd = std::find(cursor, end, '\0');
+    std::vector<std::string> lines;
+    int given = 0;
+    for (const char* line = cursor; line < blockEnd;) {
+      const char* lineEnd = std::find(line, blockEnd, '\n');
+      lines.emplace_back(line, lineEnd);
+      if (lines.back().find_first_not_of(" \t\r") != std::string::npos) {
+        ++given;
+      }
+      line = lineEnd + 1;
+    }
+    int power = seatPower(gameId, playerIds[i]);
+    if (power >= 0) {
+      rejected.clear();
+      storeOrders(gameId, power, lines, &rejected);
+      accepted[i] = given - static_cast<int32_t>(rejected.size());
+    }
+    cursor = blockEnd + 1;
+  }
+  checkReady(gameId);
+  
+  return NewInt32Array(env, accepted);
+}
+
+// Adjudicate several games at once. `gameIds` holds the IDs as UTF-8, each
+// followed by a NUL. Returns the number of orders resolved in each game,
+// or -1 for a paused game.
+napi_value AdjudicateGames(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
   
-  args.GetReturnValue().Set(emailArray);
+  if (args.Length() < 1) {
+    return ThrowTypeError(env, "Wrong number of arguments");
+  }
+  
+  void* text = nullptr;
+  size_t length = 0;
+  if (!TypedArrayContents(env, args[0], napi_uint8_array, &text, &length)) {
+    return ThrowTypeError(env, "Game IDs must be a Uint8Array");
+  }
+  
+  const char* cursor = static_cast<const char*>(text);
+  const char* end = cursor + length;
+  std::vector<int32_t> resolved;
+  while (cursor < end) {
+    const char* idEnd = std::find(cursor, end, '\0');
+    if (idEnd > cursor) {
+      resolved.push_back(adjudicateGame(std::string(cursor, idEnd)));
+    }
+    cursor = idEnd + 1;
+  }
+  
+  return NewInt32Array(env, resolved);
 }
 
 // Advanced diplomacy features
-void ProcessConditionalOrders(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
+napi_value ProcessConditionalOrders(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
   
   if (args.Length() < 2) {
-    isolate->ThrowException(Exception::TypeError(
-        String::NewFromUtf8(isolate, "Wrong number of arguments").ToLocalChecked()));
-    return;
+    return ThrowTypeError(env, "Wrong number of arguments");
   }
   
   // For now, just acknowledge the conditional orders
-  args.GetReturnValue().Set(Boolean::New(isolate, true));
+  return NewBoolean(env, true);
 }
 
-void ExtendedPressRules(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
+napi_value ExtendedPressRules(napi_env env, napi_callback_info info) {
+  CallbackArgs args(env, info);
   
   if (args.Length() < 3) {
-    isolate->ThrowException(Exception::TypeError(
-        String::NewFromUtf8(isolate, "Wrong number of arguments").ToLocalChecked()));
-    return;
+    return ThrowTypeError(env, "Wrong number of arguments");
+  }
+  
+  std::string gameId = ToString(env, args[0]);
+  std::string ruleTypeVal = ToString(env, args[1]);
+  bool value = ToBoolean(env, args[2]);
+  
+  PressFlag flag;
+  if (!PressRuleFlag(ruleTypeVal, &flag)) {
+    return NewBoolean(env, false);
   }
   
-  // Set extended press rules - for now just acknowledge
-  args.GetReturnValue().Set(Boolean::New(isolate, true));
+  // Toggle the rule on top of the game's current policy
+  PressPolicy policy = gamePressPolicy(gameId);
+  engine->pressPolicies[gameId] = value ? (policy | flag) : (policy & ~flag);
+  
+  return NewBoolean(env, true);
 }
 
 // Module initialization
-void Init(v8::Local<v8::Object> exports) {
-  NODE_SET_METHOD(exports, "initConfig", InitConfig);
-  NODE_SET_METHOD(exports, "initGame", InitGame);
-  NODE_SET_METHOD(exports, "getGameState", GetGameState);
-  NODE_SET_METHOD(exports, "validateOrder", ValidateOrder);
-  NODE_SET_METHOD(exports, "processOrders", ProcessOrders);
-  
-  NODE_SET_METHOD(exports, "setGameVariant", SetGameVariant);
-  NODE_SET_METHOD(exports, "setPressRules", SetPressRules);
-  NODE_SET_METHOD(exports, "setDeadlines", SetDeadlines);
-  NODE_SET_METHOD(exports, "setVictoryConditions", SetVictoryConditions);
-  NODE_SET_METHOD(exports, "setGameAccess", SetGameAccess);
-  
-  NODE_SET_METHOD(exports, "registerPlayer", RegisterPlayer);
-  NODE_SET_METHOD(exports, "getPlayerStatus", GetPlayerStatus);
-  NODE_SET_METHOD(exports, "sendPress", SendPress);
-  NODE_SET_METHOD(exports, "voteForDraw", VoteForDraw);
-  NODE_SET_METHOD(exports, "submitOrders", SubmitOrders);
-  
-  NODE_SET_METHOD(exports, "createGame", CreateGame);
-  NODE_SET_METHOD(exports, "listGames", ListGames);
-  NODE_SET_METHOD(exports, "getGameDetails", GetGameDetails);
-  NODE_SET_METHOD(exports, "modifyGameSettings", ModifyGameSettings);
-  NODE_SET_METHOD(exports, "setMaster", SetMaster);
-  NODE_SET_METHOD(exports, "backupGame", BackupGame);
-  NODE_SET_METHOD(exports, "restoreGame", RestoreGame);
-  
-  // Register the new functions
-  NODE_SET_METHOD(exports, "linkPlayerEmail", LinkPlayerEmail);
-  NODE_SET_METHOD(exports, "setPlayerPreferences", SetPlayerPreferences);
-  NODE_SET_METHOD(exports, "processTextInput", ProcessTextInput);
-  NODE_SET_METHOD(exports, "getTextOutput", GetTextOutput);
-  NODE_SET_METHOD(exports, "simulateInboundEmail", SimulateInboundEmail);
-  NODE_SET_METHOD(exports, "getOutboundEmails", GetOutboundEmails);
-  NODE_SET_METHOD(exports, "processConditionalOrders", ProcessConditionalOrders);
-  NODE_SET_METHOD(exports, "extendedPressRules", ExtendedPressRules);
-}
-
-NODE_MODULE(NODE_GYP_MODULE_NAME, Init)
-
-}  // namespace diplomacy 
\ No newline at end of file
+namespace {
+
+struct Export {
+  const char* name;
+  napi_callback callback;
+};
+
+const Export kExports[] = {
+  {"initConfig", InitConfig},
+  {"initGame", InitGame},
+  {"getGameState", GetGameState},
+  {"validateOrder", ValidateOrder},
+  {"processOrders", ProcessOrders},
+  {"processAdjudicationQueue", ProcessAdjudicationQueue},
+
+  {"setGameVariant", SetGameVariant},
+  {"setPressRules", SetPressRules},
+  {"setDeadlines", SetDeadlines},
+  {"setMinimumWait", SetMinimumWait},
+  {"setVictoryConditions", SetVictoryConditions},
+  {"setGameAccess", SetGameAccess},
+
+  {"registerPlayer", RegisterPlayer},
+  {"getPlayerStatus", GetPlayerStatus},
+  {"sendPress", SendPress},
+  {"getPressHistory", GetPressHistory},
+  {"searchPress", SearchPress},
+  {"voteForDraw", VoteForDraw},
+  {"concedeGame", ConcedeGame},
+  {"getGameResult", GetGameResult},
+  {"submitOrders", SubmitOrders},
+  {"getSubmittedOrders", GetSubmittedOrders},
+  {"searchOrders", SearchOrders},
+  {"setBotPlayer", SetBotPlayer},
+  {"addObserver", AddObserver},
+  {"removeObserver", RemoveObserver},
+  {"listObservers", ListObservers},
+
+  {"createGame", CreateGame},
+  {"listGames", ListGames},
+  {"getGameDetails", GetGameDetails},
+  {"modifyGameSettings", ModifyGameSettings},
+  {"setMaster", SetMaster},
+  {"applyMasterCommands", ApplyMasterCommands},
+  {"getGameControl", GetGameControl},
+  {"backupGame", BackupGame},
+  {"restoreGame", RestoreGame},
+  {"getGameStateAt", GetGameStateAt},
+  {"renderMap", RenderMap},
+
+  {"linkPlayerEmail", LinkPlayerEmail},
+  {"setPlayerPreferences", SetPlayerPreferences},
+  {"openProfileStore", OpenProfileStore},
+  {"getPlayerProfile", GetPlayerProfile},
+  {"flushProfiles", FlushProfiles},
+  {"processTextInput", ProcessTextInput},
+  {"getTextOutput", GetTextOutput},
+  {"simulateInboundEmail", SimulateInboundEmail},
+  {"getOutboundEmails", GetOutboundEmails},
+  {"submitOrdersPacked", SubmitOrdersPacked},
+  {"adjudicateGames", AdjudicateGames},
+  {"processConditionalOrders", ProcessConditionalOrders},
+  {"extendedPressRules", ExtendedPressRules},
+};
+
+// Every export is called through here: point `engine` at the calling
+// environment's engine, then run the export itself
+napi_value dispatch(napi_env env, napi_callback_info info) {
+  void* data = nullptr;
+  napi_get_cb_info(env, info, nullptr, nullptr, nullptr, &data);
+  void* instance = nullptr;
+  napi_get_instance_data(env, &instance);
+  engine = static_cast<Engine*>(instance);
+  return static_cast<const Export*>(data)->callback(env, info);
+}
+
+void deleteEngine(napi_env env, void* data, void* hint) {
+  delete static_cast<Engine*>(data);
+}
+
+}  // namespace
+
+napi_value Init(napi_env env, napi_value exports) {
+  napi_set_instance_data(env, new Engine, deleteEngine, nullptr);
+  
+  std::vector<napi_property_descriptor> properties;
+  for (const Export& entry : kExports) {
+    properties.push_back({entry.name, nullptr, dispatch, nullptr, nullptr, nullptr,
+                          static_cast<napi_property_attributes>(napi_writable | napi_enumerable |
+                                                                napi_configurable),
+                          const_cast<Export*>(&entry)});
+  }
+  napi_define_properties(env, exports, properties.size(), properties.data());
+  return exports;
+}
+
+}  // namespace diplomacy
+
+NAPI_MODULE(NODE_GYP_MODULE_NAME, diplomacy::Init)
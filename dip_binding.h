@@ -1,60 +1,83 @@
 #ifndef DIP_BINDING_H
 #define DIP_BINDING_H
 
-#include <node.h>
+#include <node_api.h>
 #include <string>
 #include <vector>
 
 namespace diplomacy {
 
 // Initialize the configuration
-void InitConfig(const v8::FunctionCallbackInfo<v8::Value>& args);
+napi_value InitConfig(napi_env env, napi_callback_info info);
 
 // Game setup functions
-void InitGame(const v8::FunctionCallbackInfo<v8::Value>& args);
-void GetGameState(const v8::FunctionCallbackInfo<v8::Value>& args);
-void ValidateOrder(const v8::FunctionCallbackInfo<v8::Value>& args);
-void ProcessOrders(const v8::FunctionCallbackInfo<v8::Value>& args);
+napi_value InitGame(napi_env env, napi_callback_info info);
+napi_value GetGameState(napi_env env, napi_callback_info info);
+napi_value ValidateOrder(napi_env env, napi_callback_info info);
+napi_value ProcessOrders(napi_env env, napi_callback_info info);
+napi_value ProcessAdjudicationQueue(napi_env env, napi_callback_info info);
 
 // Game configuration functions
-void SetGameVariant(const v8::FunctionCallbackInfo<v8::Value>& args);
-void SetPressRules(const v8::FunctionCallbackInfo<v8::Value>& args);
-void SetDeadlines(const v8::FunctionCallbackInfo<v8::Value>& args);
-void SetVictoryConditions(const v8::FunctionCallbackInfo<v8::Value>& args);
-void SetGameAccess(const v8::FunctionCallbackInfo<v8::Value>& args);
+napi_value SetGameVariant(napi_env env, napi_callback_info info);
+napi_value SetPressRules(napi_env env, napi_callback_info info);
+napi_value SetDeadlines(napi_env env, napi_callback_info info);
+napi_value SetMinimumWait(napi_env env, napi_callback_info info);
+napi_value SetVictoryConditions(napi_env env, napi_callback_info info);
+napi_value SetGameAccess(napi_env env, napi_callback_info info);
 
 // Player interaction functions
-void RegisterPlayer(const v8::FunctionCallbackInfo<v8::Value>& args);
-void GetPlayerStatus(const v8::FunctionCallbackInfo<v8::Value>& args);
-void SendPress(const v8::FunctionCallbackInfo<v8::Value>& args);
-void VoteForDraw(const v8::FunctionCallbackInfo<v8::Value>& args);
-void SubmitOrders(const v8::FunctionCallbackInfo<v8::Value>& args);
+napi_value RegisterPlayer(napi_env env, napi_callback_info info);
+napi_value GetPlayerStatus(napi_env env, napi_callback_info info);
+napi_value SendPress(napi_env env, napi_callback_info info);
+napi_value GetPressHistory(napi_env env, napi_callback_info info);
+napi_value SearchPress(napi_env env, napi_callback_info info);
+napi_value VoteForDraw(napi_env env, napi_callback_info info);
+napi_value ConcedeGame(napi_env env, napi_callback_info info);
+napi_value GetGameResult(napi_env env, napi_callback_info info);
+napi_value SubmitOrders(napi_env env, napi_callback_info info);
+napi_value GetSubmittedOrders(napi_env env, napi_callback_info info);
+napi_value SearchOrders(napi_env env, napi_callback_info info);
+napi_value SetBotPlayer(napi_env env, napi_callback_info info);
+napi_value AddObserver(napi_env env, napi_callback_info info);
+napi_value RemoveObserver(napi_env env, napi_callback_info info);
+napi_value ListObservers(napi_env env, napi_callback_info info);
 
 // Game administration functions
-void CreateGame(const v8::FunctionCallbackInfo<v8::Value>& args);
-void ListGames(const v8::FunctionCallbackInfo<v8::Value>& args);
-void GetGameDetails(const v8::FunctionCallbackInfo<v8::Value>& args);
-void ModifyGameSettings(const v8::FunctionCallbackInfo<v8::Value>& args);
-void SetMaster(const v8::FunctionCallbackInfo<v8::Value>& args);
-void BackupGame(const v8::FunctionCallbackInfo<v8::Value>& args);
-void RestoreGame(const v8::FunctionCallbackInfo<v8::Value>& args);
+napi_value CreateGame(napi_env env, napi_callback_info info);
+napi_value ListGames(napi_env env, napi_callback_info info);
+napi_value GetGameDetails(napi_env env, napi_callback_info info);
+napi_value ModifyGameSettings(napi_env env, napi_callback_info info);
+napi_value SetMaster(napi_env env, napi_callback_info info);
+napi_value ApplyMasterCommands(napi_env env, napi_callback_info info);
+napi_value GetGameControl(napi_env env, napi_callback_info info);
+napi_value BackupGame(napi_env env, napi_callback_info info);
+napi_value RestoreGame(napi_env env, napi_callback_info info);
+napi_value GetGameStateAt(napi_env env, napi_callback_info info);
+napi_value RenderMap(napi_env env, napi_callback_info info);
 
 // Player account management functions
-void LinkPlayerEmail(const v8::FunctionCallbackInfo<v8::Value>& args);
-void SetPlayerPreferences(const v8::FunctionCallbackInfo<v8::Value>& args);
+napi_value LinkPlayerEmail(napi_env env, napi_callback_info info);
+napi_value SetPlayerPreferences(napi_env env, napi_callback_info info);
+napi_value OpenProfileStore(napi_env env, napi_callback_info info);
+napi_value GetPlayerProfile(napi_env env, napi_callback_info info);
+napi_value FlushProfiles(napi_env env, napi_callback_info info);
 
 // Email and text processing functions
-void ProcessTextInput(const v8::FunctionCallbackInfo<v8::Value>& args);
-void GetTextOutput(const v8::FunctionCallbackInfo<v8::Value>& args);
-void SimulateInboundEmail(const v8::FunctionCallbackInfo<v8::Value>& args);
-void GetOutboundEmails(const v8::FunctionCallbackInfo<v8::Value>& args);
+napi_value ProcessTextInput(napi_env env, napi_callback_info info);
+napi_value GetTextOutput(napi_env env, napi_callback_info info);
+napi_value SimulateInboundEmail(napi_env env, napi_callback_info info);
+napi_value GetOutboundEmails(napi_env env, napi_callback_info info);
+
+// Bulk entry points over typed arrays
+napi_value SubmitOrdersPacked(napi_env env, napi_callback_info info);
+napi_value AdjudicateGames(napi_env env, napi_callback_info info);
 
 // Advanced diplomacy features
-void ProcessConditionalOrders(const v8::FunctionCallbackInfo<v8::Value>& args);
-void ExtendedPressRules(const v8::FunctionCallbackInfo<v8::Value>& args);
+napi_value ProcessConditionalOrders(napi_env env, napi_callback_info info);
+napi_value ExtendedPressRules(napi_env env, napi_callback_info info);
 
-// Module initialization
-void Init(v8::Local<v8::Object> exports);
+// Module initialization; runs once for every environment that loads the addon
+napi_value Init(napi_env env, napi_value exports);
 
 }  // namespace diplomacy
 
@@ -0,0 +1,533 @@
+#include <cctype>
+#include <sstream>
+#include "dip_map.h"
+
+namespace diplomacy {
+
+namespace {
+
+struct ProvinceRow {
+  const char* abbr;
+  const char* name;
+  ProvinceType type;
+  bool supplyCenter;
+  const char* home;
+  int16_t x, y;
+};
+
+const struct {
+  const char* name;
+  const char* adjective;
+} kPowers[] = {
+  {"Austria", "Austrian"}, {"England", "English"}, {"France", "French"},
+  {"Germany", "German"}, {"Italy", "Italian"}, {"Russia", "Russian"},
+  {"Turkey", "Turkish"}
+};
+
+const ProvinceRow kProvinces[] = {
+  {"ADR", "Adriatic Sea", PROVINCE_SEA, false, nullptr, 785, 758},
+  {"AEG", "Aegean Sea", PROVINCE_SEA, false, nullptr, 988, 869},
+  {"ALB", "Albania", PROVINCE_COAST, false, nullptr, 889, 816},
+  {"ANK", "Ankara", PROVINCE_COAST, true, "Turkey", 1150, 816},
+  {"APU", "Apulia", PROVINCE_COAST, false, nullptr, 823, 802},
+  {"ARM", "Armenia", PROVINCE_COAST, false, nullptr, 1311, 840},
+  {"BAL", "Baltic Sea", PROVINCE_SEA, false, nullptr, 855, 456},
+  {"BAR", "Barents Sea", PROVINCE_SEA, false, nullptr, 1273, 72},
+  {"BEL", "Belgium", PROVINCE_COAST, true, nullptr, 595, 583},
+  {"BER", "Berlin", PROVINCE_COAST, true, "Germany", 770, 533},
+  {"BLA", "Black Sea", PROVINCE_SEA, false, nullptr, 1159, 756},
+  {"BOH", "Bohemia", PROVINCE_LAND, false, nullptr, 788, 605},
+  {"BOT", "Gulf of Bothnia", PROVINCE_SEA, false, nullptr, 902, 312},
+  {"BRE", "Brest", PROVINCE_COAST, true, "France", 456, 648},
+  {"BUD", "Budapest", PROVINCE_LAND, true, "Austria", 893, 672},
+  {"BUL", "Bulgaria", PROVINCE_COAST, true, nullptr, 988, 775},
+  {"BUR", "Burgundy", PROVINCE_LAND, false, nullptr, 598, 672},
+  {"CLY", "Clyde", PROVINCE_COAST, false, nullptr, 422, 439},
+  {"CON", "Constantinople", PROVINCE_COAST, true, "Turkey", 1060, 816},
+  {"DEN", "Denmark", PROVINCE_COAST, true, nullptr, 703, 456},
+  {"EAS", "Eastern Mediterranean", PROVINCE_SEA, false, nullptr, 1121, 984},
+  {"EDI", "Edinburgh", PROVINCE_COAST, true, "England", 469, 444},
+  {"ENG", "English Channel", PROVINCE_SEA, false, nullptr, 466, 605},
+  {"FIN", "Finland", PROVINCE_COAST, false, nullptr, 1007, 288},
+  {"GAL", "Galicia", PROVINCE_LAND, false, nullptr, 969, 624},
+  {"GAS", "Gascony", PROVINCE_COAST, false, nullptr, 513, 732},
+  {"GRE", "Greece", PROVINCE_COAST, true, nullptr, 931, 852},
+  {"HEL", "Heligoland Bight", PROVINCE_SEA, false, nullptr, 656, 485},
+  {"HOL", "Holland", PROVINCE_COAST, true, nullptr, 619, 542},
+  {"ION", "Ionian Sea", PROVINCE_SEA, false, nullptr, 855, 912},
+  {"IRI", "Irish Sea", PROVINCE_SEA, false, nullptr, 390, 528},
+  {"KIE", "Kiel", PROVINCE_COAST, true, "Germany", 694, 516},
+  {"LON", "London", PROVINCE_COAST, true, "England", 513, 564},
+  {"LVN", "Livonia", PROVINCE_COAST, false, nullptr, 988, 432},
+  {"LVP", "Liverpool", PROVINCE_COAST, true, "England", 452, 504},
+  {"LYO", "Gulf of Lyon", PROVINCE_SEA, false, nullptr, 608, 792},
+  {"MAO", "Mid-Atlantic Ocean", PROVINCE_SEA, false, nullptr, 190, 744},
+  {"MAR", "Marseilles", PROVINCE_COAST, true, "France", 608, 744},
+  {"MOS", "Moscow", PROVINCE_LAND, true, "Russia", 1235, 480},
+  {"MUN", "Munich", PROVINCE_LAND, true, "Germany", 722, 624},
+  {"NAF", "North Africa", PROVINCE_COAST, false, nullptr, 475, 1008},
+  {"NAO", "North Atlantic Ocean", PROVINCE_SEA, false, nullptr, 57, 432},
+  {"NAP", "Naples", PROVINCE_COAST, true, "Italy", 804, 840},
+  {"NTH", "North Sea", PROVINCE_SEA, false, nullptr, 570, 456},
+  {"NWG", "Norwegian Sea", PROVINCE_SEA, false, nullptr, 608, 216},
+  {"NWY", "Norway", PROVINCE_COAST, true, nullptr, 703, 336},
+  {"PAR", "Paris", PROVINCE_LAND, true, "France", 551, 648},
+  {"PIC", "Picardy", PROVINCE_COAST, false, nullptr, 547, 595},
+  {"PIE", "Piedmont", PROVINCE_COAST, false, nullptr, 656, 720},
+  {"POR", "Portugal", PROVINCE_COAST, true, nullptr, 352, 852},
+  {"PRU", "Prussia", PROVINCE_COAST, false, nullptr, 884, 504},
+  {"ROM", "Rome", PROVINCE_COAST, true, "Italy", 750, 792},
+  {"RUH", "Ruhr", PROVINCE_LAND, false, nullptr, 650, 576},
+  {"RUM", "Rumania", PROVINCE_COAST, true, nullptr, 1007, 720},
+  {"SER", "Serbia", PROVINCE_LAND, true, nullptr, 906, 744},
+  {"SEV", "Sevastopol", PROVINCE_COAST, true, "Russia", 1197, 672},
+  {"SIL", "Silesia", PROVINCE_LAND, false, nullptr, 836, 576},
+  {"SKA", "Skagerrak", PROVINCE_SEA, false, nullptr, 684, 401},
+  {"SMY", "Smyrna", PROVINCE_COAST, true, "Turkey", 1064, 881},
+  {"SPA", "Spain", PROVINCE_COAST, true, nullptr, 437, 840},
+  {"STP", "St Petersburg", PROVINCE_COAST, true, "Russia", 1159, 336},
+  {"SWE", "Sweden", PROVINCE_COAST, true, nullptr, 798, 312},
+  {"SYR", "Syria", PROVINCE_COAST, false, nullptr, 1235, 929},
+  {"TRI", "Trieste", PROVINCE_COAST, true, "Austria", 798, 718},
+  {"TUN", "Tunis", PROVINCE_COAST, true, nullptr, 703, 960},
+  {"TUS", "Tuscany", PROVINCE_COAST, false, nullptr, 718, 754},
+  {"TYR", "Tyrolia", PROVINCE_LAND, false, nullptr, 733, 667},
+  {"TYS", "Tyrrhenian Sea", PROVINCE_SEA, false, nullptr, 722, 845},
+  {"UKR", "Ukraine", PROVINCE_LAND, false, nullptr, 1102, 624},
+  {"VEN", "Venice", PROVINCE_COAST, true, "Italy", 745, 706},
+  {"VIE", "Vienna", PROVINCE_LAND, true, "Austria", 823, 648},
+  {"WAL", "Wales", PROVINCE_COAST, false, nullptr, 433, 552},
+  {"WAR", "Warsaw", PROVINCE_LAND, true, "Russia", 912, 552},
+  {"WES", "Western Mediterranean", PROVINCE_SEA, false, nullptr, 551, 876},
+  {"YOR", "Yorkshire", PROVINCE_COAST, false, nullptr, 496, 499}
+};
+
+// Provinces with more than one coast, and their coasts
+const struct {
+  const char* abbr;
+  Coast coasts[2];
+} kSplitCoasts[] = {
+  {"BUL", {COAST_EAST, COAST_SOUTH}},
+  {"SPA", {COAST_NORTH, COAST_SOUTH}},
+  {"STP", {COAST_NORTH, COAST_SOUTH}}
+};
+
+// Land borders, listed from both sides
+const char* const kArmyAdjacency[] = {
+  "ALB: GRE SER TRI",
+  "ANK: ARM CON SMY",
+  "APU: NAP ROM VEN",
+  "ARM: ANK SEV SMY SYR",
+  "BEL: BUR HOL PIC RUH",
+  "BER: KIE MUN PRU SIL",
+  "BOH: GAL MUN SIL TYR VIE",
+  "BRE: GAS PAR PIC",
+  "BUD: GAL RUM SER TRI VIE",
+  "BUL: CON GRE RUM SER",
+  "BUR: BEL GAS MAR MUN PAR PIC RUH",
+  "CLY: EDI LVP",
+  "CON: ANK BUL SMY",
+  "DEN: KIE SWE",
+  "EDI: CLY LVP YOR",
+  "FIN: NWY STP SWE",
+  "GAL: BOH BUD RUM SIL UKR VIE WAR",
+  "GAS: BRE BUR MAR PAR SPA",
+  "GRE: ALB BUL SER",
+  "HOL: BEL KIE RUH",
+  "KIE: BER DEN HOL MUN RUH",
+  "LON: WAL YOR",
+  "LVN: MOS PRU STP WAR",
+  "LVP: CLY EDI WAL YOR",
+  "MAR: BUR GAS PIE SPA",
+  "MOS: LVN SEV STP UKR WAR",
+  "MUN: BER BOH BUR KIE RUH SIL TYR",
+  "NAF: TUN",
+  "NAP: APU ROM",
+  "NWY: FIN STP SWE",
+  "PAR: BRE BUR GAS PIC",
+  "PIC: BEL BRE BUR PAR",
+  "PIE: MAR TUS TYR VEN",
+  "POR: SPA",
+  "PRU: BER LVN SIL WAR",
+  "ROM: APU NAP TUS VEN",
+  "RUH: BEL BUR HOL KIE MUN",
+  "RUM: BUD BUL GAL SER SEV UKR",
+  "SER: ALB BUD BUL GRE RUM TRI",
+  "SEV: ARM MOS RUM UKR",
+  "SIL: BER BOH GAL MUN PRU WAR",
+  "SMY: ANK ARM CON SYR",
+  "SPA: GAS MAR POR",
+  "STP: FIN LVN MOS NWY",
+  "SWE: DEN FIN NWY",
+  "SYR: ARM SMY",
+  "TRI: ALB BUD SER TYR VEN VIE",
+  "TUN: NAF",
+  "TUS: PIE ROM VEN",
+  "TYR: BOH MUN PIE TRI VEN VIE",
+  "UKR: GAL MOS RUM SEV WAR",
+  "VEN: APU PIE ROM TRI TUS TYR",
+  "VIE: BOH BUD GAL TRI TYR",
+  "WAL: LON LVP YOR",
+  "WAR: GAL LVN MOS PRU SIL UKR",
+  "YOR: EDI LON LVP WAL"
+};
+
+// Fleet moves between coasts and seas, listed from both sides
+const char* const kFleetAdjacency[] = {
+  "ADR: ALB APU ION TRI VEN",
+  "AEG: BUL/SC CON EAS GRE ION SMY",
+  "ALB: ADR GRE ION TRI",
+  "ANK: ARM BLA CON",
+  "APU: ADR ION NAP VEN",
+  "ARM: ANK BLA SEV",
+  "BAL: BER BOT DEN KIE LVN PRU SWE",
+  "BAR: NWG NWY STP/NC",
+  "BEL: ENG HOL NTH PIC",
+  "BER: BAL KIE PRU",
+  "BLA: ANK ARM BUL/EC CON RUM SEV",
+  "BOT: BAL FIN LVN STP/SC SWE",
+  "BRE: ENG GAS MAO PIC",
+  "BUL/EC: BLA CON RUM",
+  "BUL/SC: AEG CON GRE",
+  "CLY: EDI LVP NAO NWG",
+  "CON: AEG ANK BLA BUL/EC BUL/SC SMY",
+  "DEN: BAL HEL KIE NTH SKA SWE",
+  "EAS: AEG ION SMY SYR",
+  "EDI: CLY NTH NWG YOR",
+  "ENG: BEL BRE IRI LON MAO NTH PIC WAL",
+  "FIN: BOT STP/SC SWE",
+  "GAS: BRE MAO SPA/NC",
+  "GRE: AEG ALB BUL/SC ION",
+  "HEL: DEN HOL KIE NTH",
+  "HOL: BEL HEL KIE NTH",
+  "ION: ADR AEG ALB APU EAS GRE NAP TUN TYS",
+  "IRI: ENG LVP MAO NAO WAL",
+  "KIE: BAL BER DEN HEL HOL",
+  "LON: ENG NTH WAL YOR",
+  "LVN: BAL BOT PRU STP/SC",
+  "LVP: CLY IRI NAO WAL",
+  "LYO: MAR PIE SPA/SC TUS TYS WES",
+  "MAO: BRE ENG GAS IRI NAF NAO POR SPA/NC SPA/SC WES",
+  "MAR: LYO PIE SPA/SC",
+  "NAF: MAO TUN WES",
+  "NAO: CLY IRI LVP MAO NWG",
+  "NAP: APU ION ROM TYS",
+  "NTH: BEL DEN EDI ENG HEL HOL LON NWG NWY SKA YOR",
+  "NWG: BAR CLY EDI NAO NTH NWY",
+  "NWY: BAR NTH NWG SKA STP/NC SWE",
+  "PIC: BEL BRE ENG",
+  "PIE: LYO MAR TUS",
+  "POR: MAO SPA/NC SPA/SC",
+  "PRU: BAL BER LVN",
+  "ROM: NAP TUS TYS",
+  "RUM: BLA BUL/EC SEV",
+  "SEV: ARM BLA RUM",
+  "SKA: DEN NTH NWY SWE",
+  "SMY: AEG CON EAS SYR",
+  "SPA/NC: GAS MAO POR",
+  "SPA/SC: LYO MAO MAR POR WES",
+  "STP/NC: BAR NWY",
+  "STP/SC: BOT FIN LVN",
+  "SWE: BAL BOT DEN FIN NWY SKA",
+  "SYR: EAS SMY",
+  "TRI: ADR ALB VEN",
+  "TUN: ION NAF TYS WES",
+  "TUS: LYO PIE ROM TYS",
+  "TYS: ION LYO NAP ROM TUN TUS WES",
+  "VEN: ADR APU TRI",
+  "WAL: ENG IRI LON LVP",
+  "WES: LYO MAO NAF SPA/SC TUN TYS",
+  "YOR: EDI LON NTH"
+};
+
+const struct {
+  const char* power;
+  UnitType type;
+  const char* location;
+} kStartingUnits[] = {
+  {"Austria", UNIT_ARMY, "VIE"}, {"Austria", UNIT_ARMY, "BUD"}, {"Austria", UNIT_FLEET, "TRI"},
+  {"England", UNIT_FLEET, "LON"}, {"England", UNIT_FLEET, "EDI"}, {"England", UNIT_ARMY, "LVP"},
+  {"France", UNIT_FLEET, "BRE"}, {"France", UNIT_ARMY, "PAR"}, {"France", UNIT_ARMY, "MAR"},
+  {"Germany", UNIT_FLEET, "KIE"}, {"Germany", UNIT_ARMY, "BER"}, {"Germany", UNIT_ARMY, "MUN"},
+  {"Italy", UNIT_FLEET, "NAP"}, {"Italy", UNIT_ARMY, "ROM"}, {"Italy", UNIT_ARMY, "VEN"},
+  {"Russia", UNIT_ARMY, "WAR"}, {"Russia", UNIT_ARMY, "MOS"}, {"Russia", UNIT_FLEET, "SEV"},
+  {"Russia", UNIT_FLEET, "STP/SC"},
+  {"Turkey", UNIT_FLEET, "ANK"}, {"Turkey", UNIT_ARMY, "CON"}, {"Turkey", UNIT_ARMY, "SMY"}
+};
+
+// Other abbreviations players commonly use
+const struct {
+  const char* alias;
+  const char* abbr;
+} kAliases[] = {
+  {"NRG", "NWG"}, {"GOL", "LYO"}, {"MID", "MAO"}, {"NAT", "NAO"},
+  {"GOB", "BOT"}, {"TYN", "TYS"}, {"ECH", "ENG"}, {"LIV", "LVP"}
+};
+
+std::string lowerCase(const std::string& text) {
+  std::string result = text;
+  for (auto& c : result) {
+    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  }
+  return result;
+}
+
+}  // namespace
+
+const Map& Map::Standard() {
+  static const Map map(SETUP_STANDARD);
+  return map;
+}
+
+const Map& Map::FleetRome() {
+  static const Map map(SETUP_FLEET_ROME);
+  return map;
+}
+
+const Map& Map::Chaos() {
+  static const Map map(SETUP_CHAOS);
+  return map;
+}
+
+Map::Map(Setup setup) : supplyCenters_(0) {
+  if (setup == SETUP_CHAOS) {
+    for (const auto& row : kProvinces) {
+      if (row.supplyCenter) {
+        AddPower(row.name, row.name);
+      }
+    }
+  } else {
+    for (const auto& power : kPowers) {
+      AddPower(power.name, power.adjective);
+    }
+  }
+
+  for (const auto& row : kProvinces) {
+    Province province;
+    province.abbr = row.abbr;
+    province.name = row.name;
+    province.type = row.type;
+    province.supplyCenter = row.supplyCenter;
+    province.x = row.x;
+    province.y = row.y;
+    if (setup == SETUP_CHAOS) {
+      province.homePower = row.supplyCenter ? FindPower(row.name) : -1;
+    } else {
+      province.homePower = row.home ? FindPower(row.home) : -1;
+    }
+
+    ProvinceId id = static_cast<ProvinceId>(provinces_.size());
+    byName_[lowerCase(province.abbr)] = id;
+    byName_[lowerCase(province.name)] = id;
+    if (province.supplyCenter) {
+      supplyCenters_++;
+    }
+    provinces_.push_back(province);
+  }
+  for (const auto& alias : kAliases) {
+    byName_[lowerCase(alias.alias)] = byName_[lowerCase(alias.abbr)];
+  }
+  for (const auto& split : kSplitCoasts) {
+    Province& province = provinces_[FindProvince(split.abbr)];
+    province.coasts.assign(split.coasts, split.coasts + 2);
+  }
+
+  int count = ProvinceCount();
+  armyAdjacent_.assign(count, std::vector<bool>(count, false));
+  armyNeighbours_.resize(count);
+  fleetNeighbours_.resize(count * 4);
+
+  for (const char* line : kArmyAdjacency) {
+    std::istringstream in(line);
+    std::string from, to;
+    in >> from;
+    ProvinceId fromId = FindProvince(from.substr(0, from.size() - 1));
+    while (in >> to) {
+      ProvinceId toId = FindProvince(to);
+      armyAdjacent_[fromId][toId] = true;
+      armyNeighbours_[fromId].push_back({toId, COAST_NONE});
+    }
+  }
+
+  for (const char* line : kFleetAdjacency) {
+    std::istringstream in(line);
+    std::string from, to;
+    in >> from;
+    Location fromLoc, toLoc;
+    ParseLocation(from.substr(0, from.size() - 1), &fromLoc);
+    while (in >> to) {
+      ParseLocation(to, &toLoc);
+      fleetNeighbours_[LocationIndex(fromLoc)].push_back(toLoc);
+    }
+  }
+
+  if (setup == SETUP_CHAOS) {
+    for (ProvinceId id = 0; id < ProvinceCount(); ++id) {
+      if (provinces_[id].supplyCenter) {
+        startingUnits_.push_back({provinces_[id].homePower, UNIT_ARMY, {id, COAST_NONE}});
+      }
+    }
+    return;
+  }
+  for (const auto& unit : kStartingUnits) {
+    Location location;
+    ParseLocation(unit.location, &location);
+    UnitType type = unit.type;
+    if (setup == SETUP_FLEET_ROME && std::string(unit.location) == "ROM") {
+      type = UNIT_FLEET;
+    }
+    startingUnits_.push_back({FindPower(unit.power), type, location});
+  }
+}
+
+void Map::AddPower(const std::string& name, const std::string& adjective) {
+  powers_.push_back(name);
+  adjectives_.push_back(adjective);
+  std::string key = name;
+  for (auto& c : key) {
+    c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+  }
+  powerKeys_.push_back(key);
+}
+
+ProvinceId Map::FindProvince(const std::string& name) const {
+  auto it = byName_.find(lowerCase(name));
+  return it != byName_.end() ? it->second : NO_PROVINCE;
+}
+
+bool Map::ParseLocation(const std::string& text, Location* location) const {
+  std::string name = text;
+  std::string coast;
+
+  size_t split = name.find_first_of("/(");
+  if (split != std::string::npos) {
+    coast = lowerCase(name.substr(split + 1));
+    if (!coast.empty() && coast.back() == ')') {
+      coast.pop_back();
+    }
+    name = name.substr(0, split);
+  }
+
+  ProvinceId id = FindProvince(name);
+  if (id == NO_PROVINCE) {
+    return false;
+  }
+
+  location->province = id;
+  location->coast = COAST_NONE;
+  if (coast.empty()) {
+    return true;
+  }
+
+  if (coast == "nc" || coast == "n" || coast == "north") {
+    location->coast = COAST_NORTH;
+  } else if (coast == "sc" || coast == "s" || coast == "south") {
+    location->coast = COAST_SOUTH;
+  } else if (coast == "ec" || coast == "e" || coast == "east") {
+    location->coast = COAST_EAST;
+  } else {
+    return false;
+  }
+
+  // Only split-coast provinces take a coast
+  const std::vector<Coast>& coasts = provinces_[id].coasts;
+  for (Coast c : coasts) {
+    if (c == location->coast) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::string Map::LocationName(const Location& location) const {
+  std::string name = provinces_[location.province].abbr;
+  if (location.coast != COAST_NONE) {
+    name += "/";
+    name += CoastName(location.coast);
+  }
+  return name;
+}
+
+bool Map::CanOccupy(UnitType type, const Location& location) const {
+  const Province& province = provinces_[location.province];
+  if (type == UNIT_ARMY) {
+    return province.type != PROVINCE_SEA && location.coast == COAST_NONE;
+  }
+  if (province.type == PROVINCE_LAND) {
+    return false;
+  }
+  // Fleets in split-coast provinces must be on one of the coasts
+  return province.coasts.empty() ? location.coast == COAST_NONE
+                                 : location.coast != COAST_NONE;
+}
+
+bool Map::ArmyAdjacent(ProvinceId from, ProvinceId to) const {
+  return armyAdjacent_[from][to];
+}
+
+bool Map::FleetAdjacent(const Location& from, const Location& to) const {
+  for (const Location& next : fleetNeighbours_[LocationIndex(from)]) {
+    if (next == to) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Map::CanReach(UnitType type, const Location& from, ProvinceId to) const {
+  if (type == UNIT_ARMY) {
+    return armyAdjacent_[from.province][to];
+  }
+  for (const Location& next : fleetNeighbours_[LocationIndex(from)]) {
+    if (next.province == to) {
+      return true;
+    }
+  }
+  return false;
+}
+
+const std::vector<Location>& Map::Neighbours(UnitType type, const Location& from) const {
+  return type == UNIT_ARMY ? armyNeighbours_[from.province]
+                           : fleetNeighbours_[LocationIndex(from)];
+}
+
+Coast Map::SoleCoast(const Location& from, ProvinceId to) const {
+  Coast found = COAST_NONE;
+  int matches = 0;
+  for (const Location& next : fleetNeighbours_[LocationIndex(from)]) {
+    if (next.province == to) {
+      found = next.coast;
+      matches++;
+    }
+  }
+  return matches == 1 ? found : COAST_NONE;
+}
+
+int Map::FindPower(const std::string& name) const {
+  std::string key = lowerCase(name);
+  for (size_t i = 0; i < powers_.size(); ++i) {
+    if (lowerCase(powers_[i]) == key) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+const char* Map::CoastName(Coast coast) {
+  switch (coast) {
+    case COAST_NORTH:
+      return "NC";
+    case COAST_SOUTH:
+      return "SC";
+    case COAST_EAST:
+      return "EC";
+    default:
+      return "";
+  }
+}
+
+int Map::LocationIndex(const Location& location) const {
+  return location.province * 4 + location.coast;
+}
+
+}  // namespace diplomacy
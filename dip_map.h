@@ -0,0 +1,146 @@
+#ifndef DIP_MAP_H
+#define DIP_MAP_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace diplomacy {
+
+typedef int16_t ProvinceId;
+const ProvinceId NO_PROVINCE = -1;
+
+enum UnitType : int8_t {
+  UNIT_ARMY = 0,
+  UNIT_FLEET = 1
+};
+
+enum Coast : int8_t {
+  COAST_NONE = 0,
+  COAST_NORTH,
+  COAST_SOUTH,
+  COAST_EAST
+};
+
+enum ProvinceType : int8_t {
+  PROVINCE_LAND = 0,   // Inland
+  PROVINCE_COAST,      // Land with a coastline
+  PROVINCE_SEA
+};
+
+// A place a unit can stand: a province, plus the coast for fleets in
+// provinces with more than one coast
+struct Location {
+  ProvinceId province;
+  Coast coast;
+
+  bool operator==(const Location& other) const {
+    return province == other.province && coast == other.coast;
+  }
+  bool operator!=(const Location& other) const { return !(*this == other); }
+};
+
+// Size of the picture province positions are given on
+const int kMapWidth = 1360;
+const int kMapHeight = 1050;
+
+struct Province {
+  std::string abbr;          // "STP"
+  std::string name;          // "St Petersburg"
+  ProvinceType type;
+  bool supplyCenter;
+  int homePower;             // Power index, or -1
+  std::vector<Coast> coasts; // Non-empty only for split coasts
+  int16_t x, y;              // Where the province is drawn, on a kMapWidth x kMapHeight picture
+};
+
+struct StartingUnit {
+  int power;
+  UnitType type;
+  Location location;
+};
+
+// Board geometry and starting setup, built once from the tables in
+// dip_map.cpp and shared by every game.
+class Map {
+ public:
+  // The standard seven-power map
+  static const Map& Standard();
+
+  // Standard geography with Italy starting F ROM instead of A ROM
+  static const Map& FleetRome();
+
+  // Standard geography with 34 powers, one per supply center, each named
+  // after and starting with an army in its center
+  static const Map& Chaos();
+
+  int ProvinceCount() const { return static_cast<int>(provinces_.size()); }
+  const Province& GetProvince(ProvinceId id) const { return provinces_[id]; }
+
+  // Province by abbreviation or full name, case-insensitive; NO_PROVINCE if unknown
+  ProvinceId FindProvince(const std::string& name) const;
+
+  // Parse "STP", "stp/sc" or "Stp(sc)"; returns false if unknown
+  bool ParseLocation(const std::string& text, Location* location) const;
+
+  // "STP/SC" style text for a location
+  std::string LocationName(const Location& location) const;
+
+  // Whether a unit of `type` may stand at `location`
+  bool CanOccupy(UnitType type, const Location& location) const;
+
+  bool ArmyAdjacent(ProvinceId from, ProvinceId to) const;
+  bool FleetAdjacent(const Location& from, const Location& to) const;
+
+  // Whether a unit at `from` can move to province `to` by itself,
+  // for fleets on any coast of it
+  bool CanReach(UnitType type, const Location& from, ProvinceId to) const;
+
+  // Places a unit at `from` could move to in one step
+  const std::vector<Location>& Neighbours(UnitType type, const Location& from) const;
+
+  // The only coast of `to` a fleet at `from` can reach, or COAST_NONE when
+  // there are none or several
+  Coast SoleCoast(const Location& from, ProvinceId to) const;
+
+  int PowerCount() const { return static_cast<int>(powers_.size()); }
+  const std::string& PowerName(int power) const { return powers_[power]; }  // "England"
+  const std::string& PowerKey(int power) const { return powerKeys_[power]; } // "ENGLAND"
+  const std::string& PowerAdjective(int power) const { return adjectives_[power]; } // "English"
+
+  // Power index by name, case-insensitive; -1 if unknown
+  int FindPower(const std::string& name) const;
+
+  int SupplyCenterCount() const { return supplyCenters_; }
+  const std::vector<StartingUnit>& StartingUnits() const { return startingUnits_; }
+
+  static const char* CoastName(Coast coast);
+
+ private:
+  enum Setup { SETUP_STANDARD, SETUP_FLEET_ROME, SETUP_CHAOS };
+
+  explicit Map(Setup setup);
+
+  void AddPower(const std::string& name, const std::string& adjective);
+
+  int LocationIndex(const Location& location) const;
+
+  std::vector<Province> provinces_;
+  std::unordered_map<std::string, ProvinceId> byName_;
+  std::vector<std::vector<bool>> armyAdjacent_;
+
+  // Fleet locations are indexed province * 4 + coast
+  std::vector<std::vector<Location>> fleetNeighbours_;
+  std::vector<std::vector<Location>> armyNeighbours_;
+
+  std::vector<std::string> powers_;
+  std::vector<std::string> powerKeys_;
+  std::vector<std::string> adjectives_;
+  std::vector<StartingUnit> startingUnits_;
+  int supplyCenters_;
+};
+
+}  // namespace diplomacy
+
+#endif // DIP_MAP_H
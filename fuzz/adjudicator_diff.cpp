@@ -0,0 +1,176 @@
+// Differential test of Adjudicate against the reference adjudicator on
+// random positions and order sets. Build from the repository root:
+//
+//   g++ -std=c++17 -O2 -pthread -I. -o build/adjudicator_diff
+//       fuzz/adjudicator_diff.cpp fuzz/reference_adjudicator.cpp
+//       adjudicator.cpp dip_map.cpp move_search.cpp
+//   build/adjudicator_diff [cases] [seed] [maxUnits]
+//
+// Exits non-zero if any case resolves differently.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include "adjudicator.h"
+#include "move_search.h"
+#include "reference_adjudicator.h"
+
+using namespace diplomacy;
+
+namespace {
+
+// Provinces within two steps of `centre`, by army or fleet
+std::vector<ProvinceId> region(const Map& map, ProvinceId centre) {
+  std::vector<ProvinceId> provinces = {centre};
+  for (size_t i = 0, ring = 0; ring < 2; ++ring) {
+    for (size_t end = provinces.size(); i < end; ++i) {
+      Location from = {provinces[i], COAST_NONE};
+      std::vector<Location> next = map.Neighbours(UNIT_ARMY, from);
+      const Province& province = map.GetProvince(provinces[i]);
+      std::vector<Coast> coasts = province.coasts.empty() ? std::vector<Coast>{COAST_NONE}
+                                                          : province.coasts;
+      for (Coast coast : coasts) {
+        const auto& fleet = map.Neighbours(UNIT_FLEET, Location{provinces[i], coast});
+        next.insert(next.end(), fleet.begin(), fleet.end());
+      }
+      for (const Location& location : next) {
+        if (std::find(provinces.begin(), provinces.end(), location.province) == provinces.end()) {
+          provinces.push_back(location.province);
+        }
+      }
+    }
+  }
+  return provinces;
+}
+
+// A random position of up to `maxUnits` units of three powers, crowded
+// into one corner of the map so that their orders interfere
+Board randomBoard(std::mt19937_64& rng, int maxUnits) {
+  const Map& map = Map::Standard();
+  Board board(map);
+  for (Unit& unit : board.units) {
+    unit.power = -1;
+  }
+  std::vector<ProvinceId> area = region(map, static_cast<ProvinceId>(rng() % map.ProvinceCount()));
+  int units = 2 + static_cast<int>(rng() % (maxUnits - 1));
+  units = std::min(units, static_cast<int>(area.size()));
+  for (int placed = 0; placed < units;) {
+    ProvinceId p = area[rng() % area.size()];
+    if (board.Occupied(p)) {
+      continue;
+    }
+    const Province& province = map.GetProvince(p);
+    UnitType type = province.type == PROVINCE_LAND ? UNIT_ARMY
+                    : province.type == PROVINCE_SEA ? UNIT_FLEET
+                    : (rng() & 1) ? UNIT_FLEET : UNIT_ARMY;
+    Coast coast = COAST_NONE;
+    if (type == UNIT_FLEET && !province.coasts.empty()) {
+      coast = province.coasts[rng() % province.coasts.size()];
+    }
+    board.units[p] = Unit{static_cast<int8_t>(rng() % 3), type, coast};
+    placed++;
+  }
+  return board;
+}
+
+// One legal order per unit: half move, a third support, the rest hold
+std::vector<Order> randomOrders(const Board& board, std::mt19937_64& rng) {
+  std::vector<Order> orders;
+  for (int power = 0; power < board.GetMap().PowerCount(); ++power) {
+    for (const UnitOptions& unit : LegalOrders(board, power)) {
+      size_t supports = unit.orders.size() - 1 - unit.moves;
+      uint64_t roll = rng() % 6;
+      if (roll < 3 && unit.moves > 0) {
+        orders.push_back(unit.orders[1 + rng() % unit.moves]);
+      } else if (roll < 5 && supports > 0) {
+        orders.push_back(unit.orders[1 + unit.moves + rng() % supports]);
+      } else {
+        orders.push_back(unit.orders[0]);
+      }
+    }
+  }
+  return orders;
+}
+
+void printCase(const Board& board, const std::vector<Order>& orders, const PhaseResult& ours,
+               const ReferenceOutcome& reference) {
+  const Map& map = board.GetMap();
+  for (const Order& order : orders) {
+    std::printf("  %s: %s\n", map.PowerName(order.power).c_str(),
+                FormatOrder(map, order).c_str());
+  }
+  for (const ResolvedOrder& resolved : ours.orders) {
+    ProvinceId p = resolved.order.unit.province;
+    std::printf("  %-24s ours %s%s, reference %s%s\n",
+                FormatOrder(map, resolved.order).c_str(),
+                resolved.result == RESULT_SUCCESS ? "ok" : "failed",
+                resolved.dislodged ? " dislodged" : "",
+                resolved.order.type != ORDER_MOVE || reference.moved[p] ? "ok" : "failed",
+                reference.dislodged[p] ? " dislodged" : "");
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  long cases = argc > 1 ? std::atol(argv[1]) : 100000;
+  uint64_t seed = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1;
+  int maxUnits = argc > 3 ? std::atoi(argv[3]) : 14;
+  std::mt19937_64 rng(seed);
+
+  long compared = 0, skipped = 0, mismatches = 0, ambiguous = 0;
+  double oursTotal = 0, oursMax = 0, referenceTotal = 0, referenceMax = 0;
+  for (long i = 0; i < cases; ++i) {
+    Board board = randomBoard(rng, maxUnits);
+    std::vector<Order> orders = randomOrders(board, rng);
+
+    auto start = std::chrono::steady_clock::now();
+    ReferenceOutcome reference;
+    bool covered = ReferenceMovement(board, orders, &reference);
+    auto middle = std::chrono::steady_clock::now();
+    Board after = board;
+    PhaseResult ours;
+    Adjudicate(&after, orders, &ours);
+    auto end = std::chrono::steady_clock::now();
+    if (!covered) {
+      skipped++;
+      continue;
+    }
+
+    double referenceUs = std::chrono::duration<double, std::micro>(middle - start).count();
+    double oursUs = std::chrono::duration<double, std::micro>(end - middle).count();
+    referenceTotal += referenceUs;
+    oursTotal += oursUs;
+    referenceMax = std::max(referenceMax, referenceUs);
+    oursMax = std::max(oursMax, oursUs);
+    compared++;
+    if (reference.consistent != 1) {
+      ambiguous++;
+    }
+
+    bool same = true;
+    for (const ResolvedOrder& resolved : ours.orders) {
+      ProvinceId p = resolved.order.unit.province;
+      bool moved = resolved.order.type == ORDER_MOVE && resolved.result == RESULT_SUCCESS;
+      if (moved != reference.moved[p] || resolved.dislodged != reference.dislodged[p]) {
+        same = false;
+      }
+    }
+    if (!same && mismatches++ < 10) {
+      std::printf("Mismatch in case %ld (%d consistent resolutions):\n", i, reference.consistent);
+      printCase(board, orders, ours, reference);
+    }
+  }
+
+  std::printf("%ld cases compared, %ld skipped, %ld mismatches, %ld with several or no resolutions\n",
+              compared, skipped, mismatches, ambiguous);
+  if (compared > 0) {
+    std::printf("adjudicator: %.2f us mean, %.2f us max\n", oursTotal / compared, oursMax);
+    std::printf("reference:   %.2f us mean, %.2f us max\n", referenceTotal / compared, referenceMax);
+  }
+  return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,96 @@
+// libFuzzer target for the order and press-rule parsers. The first input
+// byte picks the phase and the second the power ordering; the rest is
+// parsed a line at a time. Every order that parses must survive a trip
+// through FormatOrder and back, for the power it was taken for, unchanged. Build from the repository root:
+//
+//   clang++ -std=c++17 -g -O1 -fsanitize=fuzzer,address -I. -o build/parse_fuzzer
+//       fuzz/parse_fuzzer.cpp adjudicator.cpp dip_map.cpp press_policy.cpp
+//
+// Without libFuzzer, add -DFUZZ_STANDALONE to run it over input files.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include "adjudicator.h"
+#include "press_policy.h"
+
+using namespace diplomacy;
+
+namespace {
+
+// Spring 1901 movement, a retreat from Burgundy and a winter with builds
+// and removals due
+const Board* phaseBoards() {
+  static const Board* boards = [] {
+    const Map& map = Map::Standard();
+    static Board built[3] = {Board(map), Board(map), Board(map)};
+
+    Board& retreat = built[1];
+    retreat.phase = PHASE_RETREAT;
+    ProvinceId par = map.FindProvince("PAR");
+    retreat.units[map.FindProvince("BUR")] = retreat.units[par];
+    retreat.units[par].power = -1;
+    retreat.dislodged.push_back({map.FindPower("France"), UNIT_ARMY,
+                                 {map.FindProvince("BUR"), COAST_NONE},
+                                 {{par, COAST_NONE}, {map.FindProvince("PIC"), COAST_NONE}}});
+
+    Board& adjustment = built[2];
+    adjustment.season = SEASON_WINTER;
+    adjustment.phase = PHASE_ADJUSTMENT;
+    adjustment.units[map.FindProvince("PAR")].power = -1;
+    adjustment.units[map.FindProvince("KIE")].power = -1;
+    adjustment.owners[map.FindProvince("SER")] = static_cast<int8_t>(map.FindPower("Austria"));
+    adjustment.owners[map.FindProvince("LON")] = -1;
+    return built;
+  }();
+  return boards;
+}
+
+}  // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  if (size < 2) {
+    return 0;
+  }
+  const Board& board = phaseBoards()[data[0] % 3];
+  const Map& map = board.GetMap();
+  int power = data[1] % (map.PowerCount() + 1) - 1;
+  std::string text(reinterpret_cast<const char*>(data + 2), size - 2);
+
+  std::istringstream lines(text);
+  std::string line;
+  while (std::getline(lines, line)) {
+    Order order;
+    std::string error;
+    if (!ParseOrder(board, power, line, &order, &error)) {
+      continue;
+    }
+    std::string formatted = FormatOrder(map, order);
+    Order again;
+    if (!ParseOrder(board, order.power, formatted, &again, &error) ||
+        FormatOrder(map, again) != formatted || again.power != order.power) {
+      std::fprintf(stderr, "\"%s\" formats as \"%s\", which does not read back: %s\n",
+                   line.c_str(), formatted.c_str(), error.c_str());
+      std::abort();
+    }
+  }
+
+  PressPolicy policy;
+  CompilePressRules(text, &policy);
+  return 0;
+}
+
+#ifdef FUZZ_STANDALONE
+int main(int argc, char** argv) {
+  for (int i = 1; i < argc; ++i) {
+    std::ifstream in(argv[i], std::ios::binary);
+    std::string input((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t*>(input.data()), input.size());
+  }
+  return 0;
+}
+#endif
@@ -0,0 +1,217 @@
+#include "reference_adjudicator.h"
+
+namespace diplomacy {
+
+namespace {
+
+// The orders of one position with the parts every combination shares
+class Position {
+ public:
+  Position(const Board& board, const std::vector<Order>& orders)
+      : board_(board), count_(board.GetMap().ProvinceCount()), orders_(count_),
+        moveIndex_(count_, -1) {
+    for (ProvinceId p = 0; p < count_; ++p) {
+      const Unit& unit = board.units[p];
+      orders_[p] = Order{ORDER_HOLD, unit.power, unit.type, Location{p, unit.coast},
+                         NO_PROVINCE, Location{NO_PROVINCE, COAST_NONE}, false};
+    }
+    for (const Order& order : orders) {
+      ProvinceId p = order.unit.province;
+      if (order.type <= ORDER_CONVOY && board.units[p].power == order.power) {
+        orders_[p] = order;
+      }
+    }
+    for (ProvinceId p = 0; p < count_; ++p) {
+      if (board.units[p].power >= 0 && orders_[p].type == ORDER_MOVE) {
+        moveIndex_[p] = static_cast<int>(moves_.size());
+        moves_.push_back(p);
+      }
+    }
+  }
+
+  // Whether every order is one this adjudicator covers
+  bool Supported() const {
+    const Map& map = board_.GetMap();
+    for (ProvinceId p = 0; p < count_; ++p) {
+      const Order& order = orders_[p];
+      if (board_.units[p].power < 0) {
+        continue;
+      }
+      if (order.type == ORDER_CONVOY || order.viaConvoy) {
+        return false;
+      }
+      if (order.type == ORDER_MOVE && !map.CanReach(order.unitType, order.unit, order.to.province)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  size_t MoveCount() const { return moves_.size(); }
+
+  // Whether the combination `succeeded` (bit i for moves_[i]) reproduces
+  // itself; fills in who is dislodged
+  bool Consistent(uint32_t succeeded, std::vector<bool>* dislodged) const {
+    dislodged->assign(count_, false);
+    for (ProvinceId from : moves_) {
+      ProvinceId to = orders_[from].to.province;
+      if (Moved(succeeded, from) && board_.units[to].power >= 0 && !Moved(succeeded, to)) {
+        (*dislodged)[to] = true;
+      }
+    }
+
+    for (size_t i = 0; i < moves_.size(); ++i) {
+      bool wanted = (succeeded >> i) & 1;
+      if (MoveSucceeds(succeeded, *dislodged, moves_[i]) != wanted) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  ProvinceId Move(size_t index) const { return moves_[index]; }
+
+ private:
+  bool Moved(uint32_t succeeded, ProvinceId p) const {
+    return moveIndex_[p] >= 0 && ((succeeded >> moveIndex_[p]) & 1);
+  }
+
+  bool HeadToHead(ProvinceId from) const {
+    ProvinceId to = orders_[from].to.province;
+    return board_.units[to].power >= 0 && orders_[to].type == ORDER_MOVE &&
+           orders_[to].to.province == from;
+  }
+
+  // Whether the support from `p` is given and stands: it matches the
+  // supported unit's order, its giver was not dislodged, and no foreign
+  // unit attacks it from anywhere but where the support is directed
+  bool SupportStands(const std::vector<bool>& dislodged, ProvinceId p) const {
+    const Order& support = orders_[p];
+    if (board_.units[support.from].power < 0) {
+      return false;
+    }
+    const Order& supported = orders_[support.from];
+    bool holding = supported.type != ORDER_MOVE;
+    if (support.to.province == support.from ? !holding
+                                            : holding || supported.to.province != support.to.province) {
+      return false;
+    }
+    if (dislodged[p]) {
+      return false;
+    }
+    for (ProvinceId attacker : moves_) {
+      if (orders_[attacker].to.province == p && attacker != support.to.province &&
+          board_.units[attacker].power != board_.units[p].power) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Standing supports for the unit in `from` into `to`, leaving out those
+  // given by units of `excluded`
+  int Supports(const std::vector<bool>& dislodged, ProvinceId from, ProvinceId to,
+               int excluded) const {
+    int count = 0;
+    for (ProvinceId p = 0; p < count_; ++p) {
+      const Order& order = orders_[p];
+      if (board_.units[p].power >= 0 && order.type == ORDER_SUPPORT && order.from == from &&
+          order.to.province == to && board_.units[p].power != excluded &&
+          SupportStands(dislodged, p)) {
+        count++;
+      }
+    }
+    return count;
+  }
+
+  int HoldStrength(uint32_t succeeded, const std::vector<bool>& dislodged, ProvinceId p) const {
+    if (board_.units[p].power < 0) {
+      return 0;
+    }
+    if (orders_[p].type == ORDER_MOVE) {
+      return Moved(succeeded, p) ? 0 : 1;
+    }
+    return 1 + Supports(dislodged, p, p, -1);
+  }
+
+  bool MoveSucceeds(uint32_t succeeded, const std::vector<bool>& dislodged, ProvinceId from) const {
+    ProvinceId to = orders_[from].to.province;
+    int mover = board_.units[from].power;
+    int occupier = board_.units[to].power;
+    bool headToHead = HeadToHead(from);
+
+    int attack;
+    if (occupier < 0 || (!headToHead && Moved(succeeded, to))) {
+      attack = 1 + Supports(dislodged, from, to, -1);
+    } else if (occupier == mover) {
+      attack = 0;
+    } else {
+      attack = 1 + Supports(dislodged, from, to, occupier);
+    }
+
+    int resistance = headToHead ? 1 + Supports(dislodged, to, from, -1)
+                                : HoldStrength(succeeded, dislodged, to);
+    if (attack <= resistance) {
+      return false;
+    }
+    for (ProvinceId other : moves_) {
+      if (other == from || orders_[other].to.province != to) {
+        continue;
+      }
+      bool beaten = HeadToHead(other) && Moved(succeeded, to);
+      int prevent = beaten ? 0 : 1 + Supports(dislodged, other, to, -1);
+      if (attack <= prevent) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  const Board& board_;
+  int count_;
+  std::vector<Order> orders_;
+  std::vector<ProvinceId> moves_;
+  std::vector<int> moveIndex_;
+};
+
+int bitCount(uint32_t bits) {
+  int count = 0;
+  for (; bits; bits &= bits - 1) {
+    count++;
+  }
+  return count;
+}
+
+}  // namespace
+
+bool ReferenceMovement(const Board& board, const std::vector<Order>& orders,
+                       ReferenceOutcome* outcome, int maxMoves) {
+  Position position(board, orders);
+  if (!position.Supported() || position.MoveCount() > static_cast<size_t>(maxMoves)) {
+    return false;
+  }
+
+  int count = board.GetMap().ProvinceCount();
+  outcome->moved.assign(count, false);
+  outcome->dislodged.assign(count, false);
+  outcome->consistent = 0;
+
+  uint32_t best = 0;
+  std::vector<bool> dislodged;
+  for (uint32_t succeeded = 0; succeeded < (1u << position.MoveCount()); ++succeeded) {
+    if (!position.Consistent(succeeded, &dislodged)) {
+      continue;
+    }
+    if (outcome->consistent++ == 0 || bitCount(succeeded) > bitCount(best)) {
+      best = succeeded;
+      outcome->dislodged = dislodged;
+    }
+  }
+
+  for (size_t i = 0; i < position.MoveCount(); ++i) {
+    outcome->moved[position.Move(i)] = (best >> i) & 1;
+  }
+  return true;
+}
+
+}  // namespace diplomacy
@@ -0,0 +1,28 @@
+#ifndef REFERENCE_ADJUDICATOR_H
+#define REFERENCE_ADJUDICATOR_H
+
+#include <vector>
+#include "adjudicator.h"
+
+namespace diplomacy {
+
+// Outcome of a movement phase by the reference rules, per province of the
+// ordered unit
+struct ReferenceOutcome {
+  std::vector<bool> moved;       // The unit's move succeeded
+  std::vector<bool> dislodged;
+  int consistent = 0;            // Resolutions consistent with the orders
+};
+
+// A deliberately slow adjudicator to check Adjudicate against. Every
+// combination of move successes is tried, and the one kept is the one in
+// which each move's success follows from the strengths that combination
+// implies. When several are consistent (circular movement), the most
+// successful is taken. Positions with convoys, or more than `maxMoves`
+// moves, are out of its reach; it returns false for those.
+bool ReferenceMovement(const Board& board, const std::vector<Order>& orders,
+                       ReferenceOutcome* outcome, int maxMoves = 16);
+
+}  // namespace diplomacy
+
+#endif // REFERENCE_ADJUDICATOR_H
@@ -0,0 +1,132 @@
+#include <cctype>
+#include <cstdlib>
+#include <sstream>
+#include "game_control.h"
+
+namespace diplomacy {
+
+namespace {
+
+std::string upper(std::string text) {
+  for (char& c : text) {
+    c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+  }
+  return text;
+}
+
+std::string lower(std::string text) {
+  for (char& c : text) {
+    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  }
+  return text;
+}
+
+bool number(const std::string& token, int* value) {
+  if (token.empty()) {
+    return false;
+  }
+  char* end = nullptr;
+  long parsed = std::strtol(token.c_str(), &end, 10);
+  if (*end != '\0' || parsed < -1000000 || parsed > 1000000) {
+    return false;
+  }
+  *value = static_cast<int>(parsed);
+  return true;
+}
+
+}  // namespace
+
+bool ParseMasterCommand(const std::string& line, MasterCommand* command, std::string* error) {
+  std::istringstream in(line);
+  std::vector<std::string> words;
+  std::string word;
+  while (in >> word) {
+    words.push_back(word);
+  }
+  auto fail = [&](const std::string& message) {
+    *error = message;
+    return false;
+  };
+  if (words.empty()) {
+    return fail("Empty command");
+  }
+
+  command->text = line.substr(line.find_first_not_of(" \t"));
+  command->text.erase(command->text.find_last_not_of(" \t\r\n") + 1);
+  std::string verb = upper(words[0]);
+  size_t expected = 1;
+  if (verb == "PAUSE") {
+    command->action = MASTER_PAUSE;
+  } else if (verb == "RESUME") {
+    command->action = MASTER_RESUME;
+  } else if (verb == "PROCESS") {
+    command->action = MASTER_PROCESS;
+  } else if (verb == "EXTEND") {
+    command->action = MASTER_EXTEND;
+    expected = 2;
+    if (words.size() != expected || !number(words[1], &command->values[0]) ||
+        command->values[0] <= 0) {
+      return fail("EXTEND takes a number of hours");
+    }
+  } else if (verb == "EJECT") {
+    command->action = MASTER_EJECT;
+    expected = 2;
+    if (words.size() != expected) {
+      return fail("EJECT takes a power");
+    }
+    command->argument = words[1];
+  } else if (verb == "SET" && words.size() > 1) {
+    std::string setting = upper(words[1]);
+    expected = 3;
+    if (setting == "MASTER") {
+      command->action = MASTER_SET_MASTER;
+      if (words.size() != expected) {
+        return fail("SET MASTER takes an address");
+      }
+      command->argument = words[2];
+    } else if (setting == "PRESS") {
+      command->action = MASTER_PRESS;
+      if (words.size() != expected || !CompilePressRules(lower(words[2]), &command->press)) {
+        return fail("SET PRESS takes none, white, grey or broadcast");
+      }
+    } else if (setting == "WAIT") {
+      command->action = MASTER_WAIT;
+      if (words.size() != expected || !number(words[2], &command->values[0]) ||
+          command->values[0] < 0) {
+        return fail("SET WAIT takes a number of minutes");
+      }
+    } else if (setting == "VICTORY") {
+      command->action = MASTER_VICTORY;
+      if (words.size() != expected || !number(words[2], &command->values[0]) ||
+          command->values[0] <= 0) {
+        return fail("SET VICTORY takes a number of centers");
+      }
+    } else if (setting == "MODERATE" || setting == "UNMODERATE") {
+      command->action = setting == "MODERATE" ? MASTER_MODERATE : MASTER_UNMODERATE;
+      expected = 2;
+    } else if (setting == "ACCESS") {
+      command->action = MASTER_ACCESS;
+      expected = 5;
+      if (words.size() != expected) {
+        return fail("SET ACCESS takes three ratings from 0 to 5");
+      }
+      for (int i = 0; i < 3; ++i) {
+        if (!number(words[i + 2], &command->values[i]) ||
+            command->values[i] < 0 || command->values[i] > 5) {
+          return fail("SET ACCESS takes three ratings from 0 to 5");
+        }
+      }
+    } else {
+      return fail("Unknown setting " + words[1]);
+    }
+  } else {
+    return fail("Unknown command " + words[0]);
+  }
+
+  if (words.size() != expected) {
+    return fail((verb == "SET" ? verb + " " + upper(words[1]) : verb) + " takes no arguments");
+  }
+  return true;
+}
+
+}  // namespace diplomacy
@@ -0,0 +1,71 @@
+#ifndef GAME_CONTROL_H
+#define GAME_CONTROL_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "press_policy.h"
+
+namespace diplomacy {
+
+// What a master can do to a game
+enum MasterAction {
+  MASTER_SET_MASTER,   // SET MASTER <address>
+  MASTER_PAUSE,        // PAUSE
+  MASTER_RESUME,       // RESUME
+  MASTER_EXTEND,       // EXTEND <hours>
+  MASTER_PROCESS,      // PROCESS
+  MASTER_EJECT,        // EJECT <power>
+  MASTER_PRESS,        // SET PRESS <none|white|grey|broadcast>
+  MASTER_WAIT,         // SET WAIT <minutes>
+  MASTER_VICTORY,      // SET VICTORY <centers>
+  MASTER_MODERATE,     // SET MODERATE
+  MASTER_UNMODERATE,   // SET UNMODERATE
+  MASTER_ACCESS        // SET ACCESS <dedication> <ontime> <resrat>
+};
+
+// One master command. A batch is parsed once, however many games it is
+// applied to.
+struct MasterCommand {
+  MasterAction action;
+  std::string text;        // The command as given, for the journal
+  std::string argument;    // Address for SET MASTER, power for EJECT
+  int values[3] = {0, 0, 0};
+  PressPolicy press = 0;
+};
+
+// Parse a command such as "EXTEND 24" or "SET PRESS grey"; keywords are
+// not case sensitive. Returns false with the reason for anything else.
+bool ParseMasterCommand(const std::string& line, MasterCommand* command, std::string* error);
+
+// Who may take a seat in a game: the least dedication, on-time and
+// resistance ratings a player needs, each from 0 to 5
+struct GameAccess {
+  int dedication = 0;
+  int onTimeRating = 0;
+  int resistanceRating = 0;
+};
+
+// One batch of commands as applied to a game. Every game a batch touches
+// journals it under the same sequence number.
+struct ControlEntry {
+  uint64_t sequence;
+  std::string master;
+  std::string phase;                   // "S1901M", the phase it was applied in
+  std::vector<std::string> commands;
+};
+
+// The master-controlled state of one game and the journal of every batch
+// applied to it
+struct GameControl {
+  std::string master;
+  bool paused = false;
+  bool moderated = false;
+  int extensionHours = 0;              // Added to the game's deadlines
+  GameAccess access;
+  std::vector<ControlEntry> journal;
+};
+
+}  // namespace diplomacy
+
+#endif // GAME_CONTROL_H
@@ -0,0 +1,219 @@
+#include "game_end.h"
+
+namespace diplomacy {
+
+namespace {
+
+inline PowerSet bit(int slot) {
+  return PowerSet(1) << slot;
+}
+
+// Marks a DIAS vote, which is for whoever survives at the time
+const PowerSet DIAS_VOTE = ~PowerSet(0);
+
+}  // namespace
+
+GameEndTracker::GameEndTracker()
+    : dias_(true), victoryCenters_(18), maxYear_(0), survivors_(0),
+      result_(GAME_RESULT_NONE), winners_(0) {}
+
+void GameEndTracker::SetVictoryConditions(bool dias, int victoryCenters, int maxYear) {
+  if (dias != dias_) {
+    // Votes cast under the other rule no longer mean the same thing
+    for (auto& vote : drawVotes_) {
+      vote = 0;
+    }
+  }
+  dias_ = dias;
+  victoryCenters_ = victoryCenters;
+  maxYear_ = maxYear;
+
+  // A lower threshold may already have been reached
+  if (result_ != GAME_RESULT_NONE) {
+    return;
+  }
+  int leader = -1;
+  for (int slot = 0; slot < PowerCount(); ++slot) {
+    if (centers_[slot] >= victoryCenters_ && (leader < 0 || centers_[slot] > centers_[leader])) {
+      leader = slot;
+    }
+  }
+  if (leader >= 0) {
+    Finish(GAME_RESULT_VICTORY, bit(leader));
+  }
+}
+
+int GameEndTracker::AddPower(const std::string& power, int centers) {
+  auto it = slots_.find(power);
+  if (it != slots_.end()) {
+    return it->second;
+  }
+  if (powers_.size() >= static_cast<size_t>(MAX_TRACKED_POWERS)) {
+    return -1;
+  }
+
+  int slot = static_cast<int>(powers_.size());
+  powers_.push_back(power);
+  slots_[power] = slot;
+  centers_.push_back(centers);
+  drawVotes_.push_back(0);
+  concessions_.push_back(-1);
+  if (centers > 0) {
+    survivors_ |= bit(slot);
+  }
+  return slot;
+}
+
+int GameEndTracker::PowerSlot(const std::string& power) const {
+  auto it = slots_.find(power);
+  return it != slots_.end() ? it->second : -1;
+}
+
+void GameEndTracker::ApplyCenterDeltas(const std::vector<std::pair<int, int>>& deltas) {
+  if (result_ != GAME_RESULT_NONE) {
+    return;
+  }
+
+  PowerSet before = survivors_;
+  int leader = -1;
+  for (const auto& delta : deltas) {
+    int slot = delta.first;
+    if (slot < 0 || slot >= PowerCount() || delta.second == 0) {
+      continue;
+    }
+
+    int& centers = centers_[slot];
+    centers += delta.second;
+    if (centers > 0) {
+      survivors_ |= bit(slot);
+    } else {
+      survivors_ &= ~bit(slot);
+    }
+
+    // Only powers that gained can have reached the victory threshold
+    if (centers >= victoryCenters_ && (leader < 0 || centers > centers_[leader])) {
+      leader = slot;
+    }
+  }
+
+  if (leader >= 0) {
+    Finish(GAME_RESULT_VICTORY, bit(leader));
+    return;
+  }
+
+  if (survivors_ != before) {
+    // Eliminated powers no longer vote
+    for (int slot = 0; slot < PowerCount(); ++slot) {
+      if (!(survivors_ & bit(slot))) {
+        drawVotes_[slot] = 0;
+        concessions_[slot] = -1;
+      }
+    }
+
+    if (survivors_ != 0 && (survivors_ & (survivors_ - 1)) == 0) {
+      Finish(GAME_RESULT_VICTORY, survivors_);
+      return;
+    }
+    CheckDraw();
+    CheckConcession();
+  }
+}
+
+void GameEndTracker::EndOfYear(int year) {
+  if (result_ == GAME_RESULT_NONE && maxYear_ > 0 && year >= maxYear_) {
+    Finish(GAME_RESULT_DRAW, survivors_);
+  }
+}
+
+bool GameEndTracker::VoteDraw(int slot, bool vote, PowerSet drawSet) {
+  if (result_ != GAME_RESULT_NONE || slot < 0 || slot >= PowerCount() ||
+      !(survivors_ & bit(slot))) {
+    return false;
+  }
+
+  if (!vote) {
+    drawVotes_[slot] = 0;
+    return true;
+  }
+
+  if (dias_) {
+    drawVotes_[slot] = DIAS_VOTE;
+  } else {
+    drawSet = drawSet ? drawSet : survivors_;
+    if ((drawSet & ~survivors_) != 0) {
+      return false;
+    }
+    drawVotes_[slot] = drawSet;
+  }
+
+  CheckDraw();
+  return true;
+}
+
+bool GameEndTracker::Concede(int slot, int winner) {
+  if (result_ != GAME_RESULT_NONE || slot < 0 || slot >= PowerCount() ||
+      !(survivors_ & bit(slot))) {
+    return false;
+  }
+  if (winner >= 0 && (winner == slot || winner >= PowerCount() ||
+                      !(survivors_ & bit(winner)))) {
+    return false;
+  }
+
+  concessions_[slot] = winner;
+  CheckConcession();
+  return true;
+}
+
+void GameEndTracker::CheckDraw() {
+  if (result_ != GAME_RESULT_NONE || survivors_ == 0) {
+    return;
+  }
+
+  // Every survivor must have voted, and for the same set without DIAS
+  PowerSet agreed = 0;
+  for (int slot = 0; slot < PowerCount(); ++slot) {
+    if (!(survivors_ & bit(slot))) {
+      continue;
+    }
+    PowerSet vote = drawVotes_[slot];
+    if (vote == 0 || (agreed != 0 && vote != agreed)) {
+      return;
+    }
+    agreed = vote;
+  }
+
+  Finish(GAME_RESULT_DRAW, agreed == DIAS_VOTE ? survivors_ : agreed);
+}
+
+void GameEndTracker::CheckConcession() {
+  if (result_ != GAME_RESULT_NONE) {
+    return;
+  }
+
+  // The winner is whoever the first conceding survivor conceded to
+  int winner = -1;
+  for (int slot = 0; slot < PowerCount() && winner < 0; ++slot) {
+    if ((survivors_ & bit(slot)) && concessions_[slot] >= 0) {
+      winner = concessions_[slot];
+    }
+  }
+  if (winner < 0 || !(survivors_ & bit(winner))) {
+    return;
+  }
+
+  for (int slot = 0; slot < PowerCount(); ++slot) {
+    if ((survivors_ & bit(slot)) && slot != winner && concessions_[slot] != winner) {
+      return;
+    }
+  }
+
+  Finish(GAME_RESULT_CONCESSION, bit(winner));
+}
+
+void GameEndTracker::Finish(GameResult result, PowerSet winners) {
+  result_ = result;
+  winners_ = winners;
+}
+
+}  // namespace diplomacy
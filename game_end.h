@@ -0,0 +1,88 @@
+#ifndef GAME_END_H
+#define GAME_END_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace diplomacy {
+
+// How a game finished
+enum GameResult {
+  GAME_RESULT_NONE = 0,
+  GAME_RESULT_VICTORY,
+  GAME_RESULT_DRAW,
+  GAME_RESULT_CONCESSION
+};
+
+// Set of powers, one bit per power slot
+typedef uint64_t PowerSet;
+
+const int MAX_TRACKED_POWERS = 64;
+
+// Tracks draw votes, concessions and victory conditions for one game.
+// Center counts are kept per power and updated from the deltas of each
+// adjudication, so checking for the end of the game only looks at the
+// powers whose counts changed.
+class GameEndTracker {
+ public:
+  GameEndTracker();
+
+  // DIAS draws include every survivor; otherwise each vote names a set.
+  // A power already holding `victoryCenters` wins at once.
+  void SetVictoryConditions(bool dias, int victoryCenters, int maxYear);
+
+  // Add a power with its starting center count; returns its slot or -1
+  int AddPower(const std::string& power, int centers);
+
+  // Slot of a power, or -1 if it is not tracked
+  int PowerSlot(const std::string& power) const;
+
+  // Apply (slot, change) center deltas from an adjudication
+  void ApplyCenterDeltas(const std::vector<std::pair<int, int>>& deltas);
+
+  // Called once the Fall turn of `year` has been adjudicated
+  void EndOfYear(int year);
+
+  // Record a draw vote for `slot`. `drawSet` names the powers to share the
+  // draw and is ignored in DIAS games. Returns false if the vote is invalid.
+  bool VoteDraw(int slot, bool vote, PowerSet drawSet);
+
+  // Record a concession by `slot` to `winner` (-1 withdraws it)
+  bool Concede(int slot, int winner);
+
+  GameResult Result() const { return result_; }
+  PowerSet Winners() const { return winners_; }
+  PowerSet Survivors() const { return survivors_; }
+  bool Dias() const { return dias_; }
+  int VictoryCenters() const { return victoryCenters_; }
+  int MaxYear() const { return maxYear_; }
+  int Centers(int slot) const { return centers_[slot]; }
+  const std::string& PowerName(int slot) const { return powers_[slot]; }
+  int PowerCount() const { return static_cast<int>(powers_.size()); }
+
+ private:
+  void CheckDraw();
+  void CheckConcession();
+  void Finish(GameResult result, PowerSet winners);
+
+  bool dias_;
+  int victoryCenters_;
+  int maxYear_;
+
+  std::vector<std::string> powers_;
+  std::unordered_map<std::string, int> slots_;
+  std::vector<int> centers_;
+  std::vector<PowerSet> drawVotes_;  // Proposed draw set per power, 0 if none
+  std::vector<int> concessions_;     // Power conceded to, -1 if none
+  PowerSet survivors_;
+
+  GameResult result_;
+  PowerSet winners_;
+};
+
+}  // namespace diplomacy
+
+#endif // GAME_END_H
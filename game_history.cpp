@@ -0,0 +1,77 @@
+#include "game_history.h"
+
+namespace diplomacy {
+
+GameHistory::GameHistory(size_t checkpointInterval, size_t cacheSize)
+    : checkpointInterval_(checkpointInterval > 0 ? checkpointInterval : 1),
+      cacheSize_(cacheSize) {}
+
+void GameHistory::Record(const Board& before, const std::vector<Order>& orders) {
+  size_t index = phases_.size();
+  if (index % checkpointInterval_ == 0) {
+    checkpoints_.push_back(before);
+  }
+  std::string name = before.PhaseName();
+  phaseIndex_[name] = index;
+  phases_.push_back({name, orders});
+}
+
+bool GameHistory::StateAt(const std::string& phaseName, Board* board) {
+  auto it = phaseIndex_.find(phaseName);
+  if (it == phaseIndex_.end()) {
+    return false;
+  }
+  size_t index = it->second;
+
+  // Exact cache hit: move it to the front
+  for (auto entry = cache_.begin(); entry != cache_.end(); ++entry) {
+    if (entry->first == index) {
+      cache_.splice(cache_.begin(), cache_, entry);
+      *board = entry->second;
+      return true;
+    }
+  }
+
+  size_t start = 0;
+  *board = *ReplayStart(index, &start);
+  PhaseResult result;
+  for (size_t i = start; i < index; ++i) {
+    Adjudicate(board, phases_[i].orders, &result);
+  }
+  Cache(index, *board);
+  return true;
+}
+
+bool GameHistory::OrdersAt(const std::string& phaseName, std::vector<Order>* orders) const {
+  auto it = phaseIndex_.find(phaseName);
+  if (it == phaseIndex_.end()) {
+    return false;
+  }
+  *orders = phases_[it->second].orders;
+  return true;
+}
+
+const Board* GameHistory::ReplayStart(size_t index, size_t* startIndex) const {
+  size_t checkpoint = index / checkpointInterval_;
+  const Board* start = &checkpoints_[checkpoint];
+  *startIndex = checkpoint * checkpointInterval_;
+  for (const auto& entry : cache_) {
+    if (entry.first <= index && entry.first > *startIndex) {
+      start = &entry.second;
+      *startIndex = entry.first;
+    }
+  }
+  return start;
+}
+
+void GameHistory::Cache(size_t index, const Board& board) {
+  if (cacheSize_ == 0) {
+    return;
+  }
+  cache_.emplace_front(index, board);
+  if (cache_.size() > cacheSize_) {
+    cache_.pop_back();
+  }
+}
+
+}  // namespace diplomacy
@@ -0,0 +1,60 @@
+#ifndef GAME_HISTORY_H
+#define GAME_HISTORY_H
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "adjudicator.h"
+
+namespace diplomacy {
+
+// Orders of every adjudicated phase of one game, with the board saved
+// every few phases so that any past phase can be rebuilt by replaying
+// from the nearest checkpoint. Recently rebuilt boards are kept in a
+// small LRU cache, which also serves as a closer replay start.
+class GameHistory {
+ public:
+  explicit GameHistory(size_t checkpointInterval = 8, size_t cacheSize = 16);
+
+  // Record the orders adjudicated on `before`, the board as it was at the
+  // start of the phase
+  void Record(const Board& before, const std::vector<Order>& orders);
+
+  // Board at the start of a recorded phase, by "S1901M" style name.
+  // Returns false if the game has not played that phase.
+  bool StateAt(const std::string& phaseName, Board* board);
+
+  // Orders adjudicated in a recorded phase. Returns false if the game has
+  // not played that phase.
+  bool OrdersAt(const std::string& phaseName, std::vector<Order>* orders) const;
+
+  // Name of the latest recorded phase, "" before the first
+  std::string LastPhase() const { return phases_.empty() ? "" : phases_.back().name; }
+
+  size_t PhaseCount() const { return phases_.size(); }
+
+ private:
+  struct PhaseRecord {
+    std::string name;
+    std::vector<Order> orders;
+  };
+
+  typedef std::pair<size_t, Board> CachedBoard;
+
+  // Latest checkpoint or cached board at or before phase `index`
+  const Board* ReplayStart(size_t index, size_t* startIndex) const;
+  void Cache(size_t index, const Board& board);
+
+  size_t checkpointInterval_;
+  size_t cacheSize_;
+  std::vector<PhaseRecord> phases_;
+  std::unordered_map<std::string, size_t> phaseIndex_;
+  std::vector<Board> checkpoints_;  // Board at the start of phase i * interval
+  std::list<CachedBoard> cache_;    // Most recently used first
+};
+
+}  // namespace diplomacy
+
+#endif // GAME_HISTORY_H
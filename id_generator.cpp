@@ -0,0 +1,127 @@
+#include <chrono>
+#include <random>
+#include "id_generator.h"
+
+#if defined(__linux__)
+#include <errno.h>
+#include <sys/random.h>
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__)
+#include <stdlib.h>
+#endif
+
+namespace diplomacy {
+
+namespace {
+
+// In ASCII order, so tokens sort by their digits
+const char kDigits[] =
+    "0123456789"
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+    "abcdefghijklmnopqrstuvwxyz";
+const uint64_t kBase = sizeof(kDigits) - 1;
+
+// Fill `data` from the operating system's cryptographic generator
+void systemRandom(unsigned char* data, size_t length) {
+#if defined(__linux__)
+  while (length > 0) {
+    ssize_t got = getrandom(data, length, 0);
+    if (got > 0) {
+      data += got;
+      length -= static_cast<size_t>(got);
+    } else if (got < 0 && errno != EINTR) {
+      // No getrandom (ENOSYS before Linux 3.17) or it failed; random_device
+      // reads /dev/urandom for the rest, and throws if it cannot
+      break;
+    }
+  }
+  if (length == 0) {
+    return;
+  }
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__)
+  arc4random_buf(data, length);
+  return;
+#endif
+  // random_device is the system generator (rand_s) on Windows
+  std::random_device device;
+  for (size_t i = 0; i < length; ++i) {
+    data[i] = static_cast<unsigned char>(device());
+  }
+}
+
+// Random bytes for this thread, taken from the system a block at a time
+// so that drawing an ID is rarely a system call
+class RandomBuffer {
+ public:
+  RandomBuffer() : used_(sizeof(bytes_)) {}
+
+  unsigned char Byte() {
+    if (used_ == sizeof(bytes_)) {
+      systemRandom(bytes_, sizeof(bytes_));
+      used_ = 0;
+    }
+    return bytes_[used_++];
+  }
+
+  uint64_t Bits() {
+    uint64_t bits = 0;
+    for (int i = 0; i < 8; ++i) {
+      bits = bits << 8 | Byte();
+    }
+    return bits;
+  }
+
+ private:
+  unsigned char bytes_[256];
+  size_t used_;
+};
+
+RandomBuffer& buffer() {
+  thread_local RandomBuffer random;
+  return random;
+}
+
+// RandomBits as a standard generator, for the distributions
+struct SystemBits {
+  typedef uint64_t result_type;
+  static constexpr uint64_t min() { return 0; }
+  static constexpr uint64_t max() { return ~uint64_t(0); }
+  uint64_t operator()() { return RandomBits(); }
+};
+
+}  // namespace
+
+uint64_t RandomBits() {
+  return buffer().Bits();
+}
+
+int64_t RandomInRange(int64_t low, int64_t high) {
+  SystemBits bits;
+  return std::uniform_int_distribution<int64_t>(low, high)(bits);
+}
+
+std::string RandomToken(size_t length) {
+  // Bytes past the last whole multiple of the base are drawn again, so
+  // every digit is equally likely
+  const unsigned limit = 256 - 256 % kBase;
+  std::string token(length, '0');
+  for (auto& c : token) {
+    unsigned byte;
+    do {
+      byte = buffer().Byte();
+    } while (byte >= limit);
+    c = kDigits[byte % kBase];
+  }
+  return token;
+}
+
+std::string SortableToken(size_t randomLength) {
+  uint64_t ms = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count());
+  std::string token(7, '0');
+  for (size_t i = token.size(); i-- > 0; ms /= kBase) {
+    token[i] = kDigits[ms % kBase];
+  }
+  return token + RandomToken(randomLength);
+}
+
+}  // namespace diplomacy
@@ -0,0 +1,31 @@
+#ifndef ID_GENERATOR_H
+#define ID_GENERATOR_H
+
+#include <cstdint>
+#include <string>
+
+namespace diplomacy {
+
+// Random numbers for identifiers, which must not be guessable from the
+// ones already seen. They come from the operating system's cryptographic
+// generator (getrandom, arc4random_buf, or random_device on Windows), read
+// a block at a time into a buffer per thread so that most IDs cost no
+// system call. Uniqueness is the caller's to check against the IDs
+// already issued.
+
+// 64 uniformly random bits
+uint64_t RandomBits();
+
+// Uniform in [low, high]
+int64_t RandomInRange(int64_t low, int64_t high);
+
+// `length` characters of [0-9A-Za-z]
+std::string RandomToken(size_t length);
+
+// A token that sorts after any made in an earlier millisecond: the time in
+// seven base-62 digits, then `randomLength` random characters
+std::string SortableToken(size_t randomLength);
+
+}  // namespace diplomacy
+
+#endif // ID_GENERATOR_H
@@ -36,12 +36,118 @@ interface OutboundEmail {
   body: string;
 }
 
+interface PressMessage {
+  id: number;
+  from: string;
+  to: string[];
+  broadcast: boolean;
+  grey: boolean;
+  phase: string;
+  body: string;
+}
+
+interface PressOptions {
+  grey?: boolean;
+  fake?: boolean;
+}
+
+interface PressHistory {
+  total: number;
+  messages: PressMessage[];
+}
+
+interface BoardUnit {
+  power: string;
+  type: 'A' | 'F';
+  location: string;
+}
+
+interface HistoricalState {
+  year: number;
+  season: string;
+  phase: string;
+  units: BoardUnit[];
+  dislodged: BoardUnit[];
+  centers: Record<string, string[]>;
+}
+
+interface OrderSubmission {
+  success: boolean;
+  ordersAccepted: boolean;
+  version: number;
+  rejected: { order: string; error: string }[];
+  ready: boolean;
+  error?: string;
+}
+
+interface SubmittedOrders {
+  phase: string;
+  version: number;
+  orders: string[];
+  missing: string[];
+  ready: boolean;
+}
+
+interface Observer {
+  address: string;
+  delay: number;
+}
+
+interface SearchResult {
+  orders: string[];
+  score: number;
+  evaluations: number;
+  threads: number;
+}
+
+interface GameResult {
+  finished: boolean;
+  result: 'none' | 'victory' | 'draw' | 'concession';
+  winners: string[];
+}
+
 interface PlayerPreferences {
   notifications: boolean;
   deadlineReminders: boolean;
   orderConfirmation: boolean;
 }
 
+interface PlayerProfile extends PlayerPreferences {
+  playerId: number;
+  vacationStart: number; // ms since the epoch, 0 when no vacation is set
+  vacationEnd: number; // midnight after the last day away
+  level: string;
+  address: string;
+}
+
+interface ProfileStoreStatus {
+  success: boolean;
+  profiles: number;
+  error?: string;
+}
+
+interface MasterBatchResult {
+  success: boolean;
+  sequence: number;
+  errors: { gameId: string; command: string; error: string }[];
+}
+
+interface ControlEntry {
+  sequence: number;
+  master: string;
+  phase: string;
+  commands: string[];
+}
+
+interface GameControl {
+  master: string;
+  paused: boolean;
+  moderated: boolean;
+  extensionHours: number;
+  access: { dedication: number; onTimeRating: number; resistanceRating: number };
+  journal: ControlEntry[];
+}
+
 interface GameDetails {
   id: string;
   name: string;
@@ -62,8 +168,9 @@ interface GameDetails {
   }[];
 }
 
-type GameVariant = 'standard' | 'machiavelli';
-type PressType = 'none' | 'white' | 'grey';
+type GameVariant = 'standard' | 'build-anywhere' | 'machiavelli' | 'fleet-rome' | 'chaos';
+type PressType = 'none' | 'white' | 'grey' | 'broadcast';
+type PressRule = 'white' | 'grey' | 'partial' | 'broadcast' | 'fake' | 'observer' | 'movement' | 'retreat' | 'adjustment';
 
 interface DiplomacyGame {
   initGame(variant: string, playerCount: number): boolean;
@@ -80,10 +187,12 @@ interface DiplomacyGame {
   };
   validateOrder(order: string, playerId: number): boolean;
   processOrders(gameId: string, playerId: number, orders: string[] | string): number;
+  processAdjudicationQueue(): string[];
   setGameVariant(variant: string, gameId: string): boolean;
   setPressRules(pressType: string, gameId: string): boolean;
   setDeadlines(deadline: number, grace: number, gameId: string): boolean;
-  setVictoryConditions(dias: boolean, gameId: string): boolean;
+  setMinimumWait(minutes: number, gameId: string): boolean;
+  setVictoryConditions(dias: boolean, gameId: string, victoryCenters?: number, maxYear?: number): boolean;
   setGameAccess(dedication: number, onTimeRating: number, resistanceRating: number, gameId: string): boolean;
 
   // New player interaction functions
@@ -97,21 +206,33 @@ interface DiplomacyGame {
     units: number;
     centers: number;
   };
-  sendPress(sender: number, recipient: number | string, message: string, gameId: string): {
+  sendPress(sender: number, recipient: number | string, message: string, gameId: string, options?: boolean | PressOptions): {
     success: boolean;
+    messageId?: number;
   };
-  voteForDraw(playerId: number, vote: boolean, gameId: string): {
+  getPressHistory(gameId: string, playerId: number, offset?: number, limit?: number): PressHistory;
+  searchPress(gameId: string, playerId: number, query: string, limit?: number): PressMessage[];
+  voteForDraw(playerId: number, vote: boolean, gameId: string, drawPowers?: string[]): {
     success: boolean;
+    drawAccepted: boolean;
   };
-  submitOrders(playerId: number, orders: string, gameId: string): {
+  concedeGame(playerId: number, winner: string | null, gameId: string): {
     success: boolean;
-    ordersAccepted: boolean;
   };
+  getGameResult(gameId: string): GameResult;
+  submitOrders(playerId: number, orders: string | string[], gameId: string): OrderSubmission;
+  getSubmittedOrders(gameId: string, playerId: number): SubmittedOrders;
+  searchOrders(gameId: string, power: string, timeBudgetMs?: number, threads?: number): SearchResult;
+  setBotPlayer(gameId: string, power: string, timeBudgetMs: number): boolean;
+  addObserver(gameId: string, address: string, delayPhases?: number): boolean;
+  removeObserver(gameId: string, address: string): boolean;
+  listObservers(gameId: string): Observer[];
 
   // New game administration functions
-  createGame(name: string, description: string, variant?: string): {
+  createGame(variant: string, name: string, playerCount?: number | string): {
     success: boolean;
     gameId: string;
+    error?: string;
   };
   listGames(): {
     id: string;
@@ -119,13 +240,11 @@ interface DiplomacyGame {
     phase: string;
     players: number;
   }[];
-  getGameDetails(gameId: string): GameDetails;
-  modifyGameSettings(gameId: string, settings: Record<string, any>): {
-    success: boolean;
-  };
-  setMaster(gameId: string, masterId: string): {
-    success: boolean;
-  };
+  getGameDetails(gameId: string): GameDetails | null;
+  modifyGameSettings(gameId: string, settings: Record<string, any>): MasterBatchResult;
+  setMaster(gameId: string, masterId: string): MasterBatchResult;
+  applyMasterCommands(master: string, gameIds: string | string[], commands: string | string[]): MasterBatchResult;
+  getGameControl(gameId: string): GameControl;
   backupGame(gameId: string): {
     success: boolean;
     backupId: string;
@@ -134,10 +253,15 @@ interface DiplomacyGame {
     success: boolean;
     gameId: string;
   };
+  getGameStateAt(gameId: string, year: number, season: string, phase: string): HistoricalState | null;
+  renderMap(gameId: string, phase?: string): string | null;
   
   // Player account management functions
   linkPlayerEmail(newEmail: string, existingEmail: string): boolean;
   setPlayerPreferences(playerId: number, preferences: PlayerPreferences): boolean;
+  openProfileStore(path: string): ProfileStoreStatus;
+  getPlayerProfile(playerId: number): PlayerProfile | null;
+  flushProfiles(): boolean;
   
   // Email and text processing functions
   processTextInput(text: string, fromEmail: string): boolean;
@@ -145,9 +269,13 @@ interface DiplomacyGame {
   simulateInboundEmail(subject: string, body: string, fromEmail: string): boolean;
   getOutboundEmails(): OutboundEmail[];
   
+  // Bulk entry points over typed arrays
+  submitOrdersPacked(gameId: string, playerIds: Int32Array, orders: Uint8Array): Int32Array;
+  adjudicateGames(gameIds: Uint8Array): Int32Array;
+  
   // Advanced diplomacy features
   processConditionalOrders(playerId: number, orders: string): boolean;
-  extendedPressRules(gameId: string, ruleType: string, value: boolean): boolean;
+  extendedPressRules(gameId: string, ruleType: PressRule, value: boolean): boolean;
 }
 
 // Attempt to load the native addon
@@ -162,16 +290,28 @@ try {
     getGameState: () => ({ phase: '', season: '', year: 0, players: [] }),
     validateOrder: () => false,
     processOrders: () => 0,
+    processAdjudicationQueue: () => [],
     setGameVariant: () => false,
     setPressRules: () => false,
     setDeadlines: () => false,
+    setMinimumWait: () => false,
     setVictoryConditions: () => false,
     setGameAccess: () => false,
     registerPlayer: () => ({ success: false, playerId: 0 }),
     getPlayerStatus: () => ({ power: '', status: '', units: 0, centers: 0 }),
     sendPress: () => ({ success: false }),
-    voteForDraw: () => ({ success: false }),
-    submitOrders: () => ({ success: false, ordersAccepted: false }),
+    getPressHistory: () => ({ total: 0, messages: [] }),
+    searchPress: () => [],
+    voteForDraw: () => ({ success: false, drawAccepted: false }),
+    concedeGame: () => ({ success: false }),
+    getGameResult: () => ({ finished: false, result: 'none', winners: [] }),
+    submitOrders: () => ({ success: false, ordersAccepted: false, version: 0, rejected: [], ready: false }),
+    getSubmittedOrders: () => ({ phase: '', version: 0, orders: [], missing: [], ready: false }),
+    searchOrders: () => ({ orders: [], score: 0, evaluations: 0, threads: 0 }),
+    setBotPlayer: () => false,
+    addObserver: () => false,
+    removeObserver: () => false,
+    listObservers: () => [],
     createGame: () => ({ success: false, gameId: '' }),
     listGames: () => [],
     getGameDetails: () => ({
@@ -189,16 +329,28 @@ try {
       started: false,
       playerList: []
     } as GameDetails),
-    modifyGameSettings: () => ({ success: false }),
-    setMaster: () => ({ success: false }),
+    modifyGameSettings: () => ({ success: false, sequence: 0, errors: [] }),
+    setMaster: () => ({ success: false, sequence: 0, errors: [] }),
+    applyMasterCommands: () => ({ success: false, sequence: 0, errors: [] }),
+    getGameControl: () => ({
+      master: '', paused: false, moderated: false, extensionHours: 0,
+      access: { dedication: 0, onTimeRating: 0, resistanceRating: 0 }, journal: []
+    }),
     backupGame: () => ({ success: false, backupId: '' }),
     restoreGame: () => ({ success: false, gameId: '' }),
+    getGameStateAt: () => null,
+    renderMap: () => null,
     linkPlayerEmail: () => false,
     setPlayerPreferences: () => false,
+    openProfileStore: () => ({ success: false, profiles: 0 }),
+    getPlayerProfile: () => null,
+    flushProfiles: () => false,
     processTextInput: () => false,
     getTextOutput: () => '',
     simulateInboundEmail: () => false,
     getOutboundEmails: () => [],
+    submitOrdersPacked: () => new Int32Array(0),
+    adjudicateGames: () => new Int32Array(0),
     processConditionalOrders: () => false,
     extendedPressRules: () => false
   };
@@ -209,43 +361,65 @@ export const initGame = binding.initGame;
 export const getGameState = binding.getGameState;
 export const validateOrder = binding.validateOrder;
 export const processOrders = binding.processOrders;
+export const processAdjudicationQueue = binding.processAdjudicationQueue;
 export const setGameVariant = binding.setGameVariant;
 export const setPressRules = binding.setPressRules;
 export const setDeadlines = binding.setDeadlines;
+export const setMinimumWait = binding.setMinimumWait;
 export const setVictoryConditions = binding.setVictoryConditions;
 export const setGameAccess = binding.setGameAccess;
 
 export const registerPlayer = binding.registerPlayer;
 export const getPlayerStatus = binding.getPlayerStatus;
 export const sendPress = binding.sendPress;
+export const getPressHistory = binding.getPressHistory;
+export const searchPress = binding.searchPress;
 export const voteForDraw = binding.voteForDraw;
+export const concedeGame = binding.concedeGame;
+export const getGameResult = binding.getGameResult;
 export const submitOrders = binding.submitOrders;
+export const getSubmittedOrders = binding.getSubmittedOrders;
+export const searchOrders = binding.searchOrders;
+export const setBotPlayer = binding.setBotPlayer;
+export const addObserver = binding.addObserver;
+export const removeObserver = binding.removeObserver;
+export const listObservers = binding.listObservers;
 
 export const createGame = binding.createGame;
 export const listGames = binding.listGames;
 export const getGameDetails = binding.getGameDetails;
 export const modifyGameSettings = binding.modifyGameSettings;
 export const setMaster = binding.setMaster;
+export const applyMasterCommands = binding.applyMasterCommands;
+export const getGameControl = binding.getGameControl;
 export const backupGame = binding.backupGame;
 export const restoreGame = binding.restoreGame;
+export const getGameStateAt = binding.getGameStateAt;
+export const renderMap = binding.renderMap;
 
 // Export the new functions
 export const linkPlayerEmail = binding.linkPlayerEmail;
 export const setPlayerPreferences = binding.setPlayerPreferences;
+export const openProfileStore = binding.openProfileStore;
+export const getPlayerProfile = binding.getPlayerProfile;
+export const flushProfiles = binding.flushProfiles;
 export const processTextInput = binding.processTextInput;
 export const getTextOutput = binding.getTextOutput;
 export const simulateInboundEmail = binding.simulateInboundEmail;
 export const getOutboundEmails = binding.getOutboundEmails;
+export const submitOrdersPacked = binding.submitOrdersPacked;
+export const adjudicateGames = binding.adjudicateGames;
 export const processConditionalOrders = binding.processConditionalOrders;
 export const extendedPressRules = binding.extendedPressRules;
 
 // Export types
-export type { Player, GameState, OutboundEmail, PlayerPreferences, GameDetails };
+export type { Player, GameState, OutboundEmail, PlayerPreferences, PlayerProfile, ProfileStoreStatus, GameDetails, PressMessage, PressHistory, PressOptions, GameResult, BoardUnit, HistoricalState, SearchResult, Observer, OrderSubmission, SubmittedOrders, MasterBatchResult, ControlEntry, GameControl };
 
 // Export the DiplomacyAddon interface for TypeScript users
 export interface DiplomacyAddon {
   initGame(variant: GameVariant, numPlayers: number): void;
   processOrders(gameId: string, playerId: number, orders: string[] | string): number;
+  processAdjudicationQueue(): string[];
   validateOrder(order: string, playerId: number): boolean;
   getGameState(): GameState;
   registerPlayer(name: string, email: string, power: string, gameId: string): {
@@ -258,27 +432,48 @@ export interface DiplomacyAddon {
     units: number;
     centers: number;
   };
-  sendPress(sender: number, recipient: number | string, message: string, gameId: string): {
+  sendPress(sender: number, recipient: number | string, message: string, gameId: string, options?: boolean | PressOptions): {
     success: boolean;
+    messageId?: number;
   };
-  voteForDraw(playerId: number, vote: boolean, gameId: string): {
+  getPressHistory(gameId: string, playerId: number, offset?: number, limit?: number): PressHistory;
+  searchPress(gameId: string, playerId: number, query: string, limit?: number): PressMessage[];
+  voteForDraw(playerId: number, vote: boolean, gameId: string, drawPowers?: string[]): {
     success: boolean;
+    drawAccepted: boolean;
   };
-  submitOrders(playerId: number, orders: string, gameId: string): {
+  concedeGame(playerId: number, winner: string | null, gameId: string): {
     success: boolean;
-    ordersAccepted: boolean;
   };
+  getGameResult(gameId: string): GameResult;
+  getGameStateAt(gameId: string, year: number, season: string, phase: string): HistoricalState | null;
+  renderMap(gameId: string, phase?: string): string | null;
+  applyMasterCommands(master: string, gameIds: string | string[], commands: string | string[]): MasterBatchResult;
+  getGameControl(gameId: string): GameControl;
+  submitOrders(playerId: number, orders: string | string[], gameId: string): OrderSubmission;
+  getSubmittedOrders(gameId: string, playerId: number): SubmittedOrders;
+  searchOrders(gameId: string, power: string, timeBudgetMs?: number, threads?: number): SearchResult;
+  setBotPlayer(gameId: string, power: string, timeBudgetMs: number): boolean;
+  addObserver(gameId: string, address: string, delayPhases?: number): boolean;
+  removeObserver(gameId: string, address: string): boolean;
+  listObservers(gameId: string): Observer[];
   linkPlayerEmail(newEmail: string, existingEmail: string): boolean;
   setPlayerPreferences(playerId: number, preferences: PlayerPreferences): boolean;
+  openProfileStore(path: string): ProfileStoreStatus;
+  getPlayerProfile(playerId: number): PlayerProfile | null;
+  flushProfiles(): boolean;
   setGameVariant(variant: GameVariant, gameId: string): boolean;
   setPressRules(pressType: PressType, gameId: string): boolean;
   setDeadlines(deadline: number, grace: number, gameId: string): boolean;
-  setVictoryConditions(dias: boolean, gameId: string): boolean;
+  setMinimumWait(minutes: number, gameId: string): boolean;
+  setVictoryConditions(dias: boolean, gameId: string, victoryCenters?: number, maxYear?: number): boolean;
   setGameAccess(dedication: number, ontime: number, resrat: number, gameId: string): boolean;
   processTextInput(text: string, fromEmail: string): boolean;
   getTextOutput(playerId: number): string;
   simulateInboundEmail(subject: string, body: string, fromEmail: string): boolean;
   getOutboundEmails(): OutboundEmail[];
+  submitOrdersPacked(gameId: string, playerIds: Int32Array, orders: Uint8Array): Int32Array;
+  adjudicateGames(gameIds: Uint8Array): Int32Array;
   processConditionalOrders(playerId: number, orders: string): boolean;
-  extendedPressRules(gameId: string, ruleType: string, value: boolean): boolean;
+  extendedPressRules(gameId: string, ruleType: PressRule, value: boolean): boolean;
 }
\ No newline at end of file
@@ -0,0 +1,423 @@
+#include "map_renderer.h"
+
+#include <cmath>
+#include <cstdio>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace diplomacy {
+
+namespace {
+
+const char* const kSeasonNames[] = {"Spring", "Fall", "Winter"};
+const char* const kPhaseNames[] = {"Movement", "Retreat", "Adjustment"};
+
+const struct {
+  const char* power;
+  const char* colour;
+} kStandardColours[] = {
+  {"Austria", "#c0392b"}, {"England", "#2c3e9e"}, {"France", "#3ea6e0"},
+  {"Germany", "#5d5d5d"}, {"Italy", "#2e8b57"}, {"Russia", "#8e5bb5"},
+  {"Turkey", "#e0b020"}
+};
+
+const double kProvinceRadius = 13;
+const double kDislodgedOffset = 14;   // Dislodged units stand aside from the occupier
+const int kLegendColumns = 7;
+const int kLegendRow = 24;
+
+// Where a unit at `location` is drawn; fleets on split coasts stand off
+// toward their coast
+void anchor(const Map& map, const Location& location, double* x, double* y) {
+  const Province& province = map.GetProvince(location.province);
+  *x = province.x;
+  *y = province.y;
+  if (!province.coasts.empty()) {
+    if (location.coast == COAST_NORTH) {
+      *y -= 18;
+    } else if (location.coast == COAST_SOUTH) {
+      *y += 18;
+    } else if (location.coast == COAST_EAST) {
+      *x += 18;
+    }
+  }
+}
+
+// Neighbouring provinces, each pair once
+std::vector<std::pair<ProvinceId, ProvinceId>> links(const Map& map) {
+  std::vector<std::vector<bool>> seen(map.ProvinceCount(), std::vector<bool>(map.ProvinceCount()));
+  std::vector<std::pair<ProvinceId, ProvinceId>> result;
+  auto add = [&](ProvinceId a, ProvinceId b) {
+    if (a > b) {
+      std::swap(a, b);
+    }
+    if (!seen[a][b]) {
+      seen[a][b] = true;
+      result.emplace_back(a, b);
+    }
+  };
+  for (ProvinceId p = 0; p < map.ProvinceCount(); ++p) {
+    const Province& province = map.GetProvince(p);
+    if (province.type != PROVINCE_SEA) {
+      for (const Location& next : map.Neighbours(UNIT_ARMY, Location{p, COAST_NONE})) {
+        add(p, next.province);
+      }
+    }
+    if (province.type == PROVINCE_LAND) {
+      continue;
+    }
+    std::vector<Coast> coasts = province.coasts;
+    if (coasts.empty()) {
+      coasts.push_back(COAST_NONE);
+    }
+    for (Coast coast : coasts) {
+      for (const Location& next : map.Neighbours(UNIT_FLEET, Location{p, coast})) {
+        add(p, next.province);
+      }
+    }
+  }
+  return result;
+}
+
+std::string buildBaseLayer(const Map& map) {
+  std::string svg;
+  char line[256];
+  svg += "<g id=\"base\">\n";
+  snprintf(line, sizeof line, "<rect width=\"%d\" height=\"%d\" fill=\"#dbe7f0\"/>\n", kMapWidth, kMapHeight);
+  svg += line;
+
+  svg += "<g stroke=\"#9aa7b0\" stroke-width=\"1.5\">\n";
+  for (const auto& link : links(map)) {
+    const Province& a = map.GetProvince(link.first);
+    const Province& b = map.GetProvince(link.second);
+    snprintf(line, sizeof line, "<line x1=\"%d\" y1=\"%d\" x2=\"%d\" y2=\"%d\"/>\n", a.x, a.y, b.x, b.y);
+    svg += line;
+  }
+  svg += "</g>\n";
+
+  // Supply centers have a heavy ring, which ownership later fills in
+  svg += "<g font-family=\"sans-serif\" font-size=\"11\" text-anchor=\"middle\">\n";
+  for (ProvinceId p = 0; p < map.ProvinceCount(); ++p) {
+    const Province& province = map.GetProvince(p);
+    snprintf(line, sizeof line,
+             "<circle cx=\"%d\" cy=\"%d\" r=\"%g\" fill=\"%s\" stroke=\"%s\" stroke-width=\"%s\"/>"
+             "<text x=\"%d\" y=\"%d\">%s</text>\n",
+             province.x, province.y, kProvinceRadius,
+             province.type == PROVINCE_SEA ? "#b5d3ea" : "#efe6cf",
+             province.supplyCenter ? "#333" : "#8a8a8a", province.supplyCenter ? "2.5" : "1",
+             province.x, province.y + 27, province.abbr.c_str());
+    svg += line;
+  }
+  svg += "</g>\n</g>\n";
+  return svg;
+}
+
+}  // namespace
+
+std::string PowerColour(const Map& map, int power) {
+  const std::string& name = map.PowerName(power);
+  if (map.PowerCount() == 7) {
+    for (const auto& entry : kStandardColours) {
+      if (name == entry.power) {
+        return entry.colour;
+      }
+    }
+  }
+  // Golden-angle steps keep neighbouring indices far apart in hue
+  char colour[32];
+  snprintf(colour, sizeof colour, "hsl(%d,60%%,50%%)", static_cast<int>(std::fmod(power * 137.5, 360.0)));
+  return colour;
+}
+
+std::shared_ptr<const std::string> MapRenderer::BaseLayer(const Map& map) {
+  static std::mutex mutex;
+  static std::unordered_map<const Map*, std::shared_ptr<const std::string>> layers;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto& layer = layers[&map];
+  if (!layer) {
+    layer = std::make_shared<const std::string>(buildBaseLayer(map));
+  }
+  return layer;
+}
+
+const std::string& MapRenderer::Render(const Board& board, const std::vector<ResolvedOrder>& orders) {
+  const Map& map = board.GetMap();
+  int legendRows = (map.PowerCount() + kLegendColumns - 1) / kLegendColumns;
+  int height = kMapHeight + legendRows * kLegendRow + 16;
+
+  buffer_.clear();
+  buffer_ += "<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\"0 0 ";
+  AppendNumber(kMapWidth);
+  buffer_ += ' ';
+  AppendNumber(height);
+  buffer_ += "\" width=\"";
+  AppendNumber(kMapWidth);
+  buffer_ += "\" height=\"";
+  AppendNumber(height);
+  buffer_ += "\">\n";
+  buffer_ += *BaseLayer(map);
+
+  buffer_ += "<g id=\"overlay\" font-family=\"sans-serif\">\n";
+  DrawOwnership(board);
+  DrawUnits(board, orders);
+  for (const ResolvedOrder& resolved : orders) {
+    DrawOrder(board, resolved);
+  }
+  DrawLegend(board);
+  buffer_ += "</g>\n</svg>\n";
+  return buffer_;
+}
+
+void MapRenderer::DrawOwnership(const Board& board) {
+  const Map& map = board.GetMap();
+  for (ProvinceId p = 0; p < map.ProvinceCount(); ++p) {
+    if (board.owners[p] < 0 || !map.GetProvince(p).supplyCenter) {
+      continue;
+    }
+    const Province& province = map.GetProvince(p);
+    buffer_ += "<circle cx=\"";
+    AppendNumber(province.x);
+    buffer_ += "\" cy=\"";
+    AppendNumber(province.y);
+    buffer_ += "\" r=\"";
+    AppendNumber(kProvinceRadius);
+    buffer_ += "\" fill=\"" + PowerColour(map, board.owners[p]) +
+               "\" fill-opacity=\"0.45\" stroke=\"#333\" stroke-width=\"2.5\"/>\n";
+  }
+}
+
+void MapRenderer::DrawUnits(const Board& board, const std::vector<ResolvedOrder>& orders) {
+  const Map& map = board.GetMap();
+  std::vector<bool> dislodged(map.ProvinceCount());
+  for (const ResolvedOrder& resolved : orders) {
+    if (resolved.dislodged && resolved.order.unit.province != NO_PROVINCE) {
+      dislodged[resolved.order.unit.province] = true;
+    }
+  }
+
+  double x, y;
+  for (ProvinceId p = 0; p < map.ProvinceCount(); ++p) {
+    const Unit& unit = board.units[p];
+    if (unit.power >= 0) {
+      anchor(map, Location{p, unit.coast}, &x, &y);
+      AppendUnit(x, y, unit.type, PowerColour(map, unit.power), dislodged[p]);
+    }
+  }
+  // Units waiting to retreat stand beside the province they were driven from
+  for (const DislodgedUnit& unit : board.dislodged) {
+    anchor(map, unit.location, &x, &y);
+    AppendUnit(x + kDislodgedOffset, y + kDislodgedOffset, unit.type, PowerColour(map, unit.power), true);
+  }
+}
+
+void MapRenderer::DrawOrder(const Board& board, const ResolvedOrder& resolved) {
+  const Map& map = board.GetMap();
+  const Order& order = resolved.order;
+  bool failed = resolved.result != RESULT_SUCCESS;
+  std::string colour = order.power >= 0 ? PowerColour(map, order.power) : "#000";
+  double x1, y1, x2, y2;
+
+  switch (order.type) {
+    case ORDER_MOVE:
+      anchor(map, order.unit, &x1, &y1);
+      anchor(map, order.to, &x2, &y2);
+      AppendArrow(x1, y1, x2, y2, colour, nullptr, true, failed);
+      break;
+    case ORDER_RETREAT:
+      anchor(map, order.unit, &x1, &y1);
+      anchor(map, order.to, &x2, &y2);
+      AppendArrow(x1 + kDislodgedOffset, y1 + kDislodgedOffset, x2, y2, colour, nullptr, true, failed);
+      break;
+    case ORDER_SUPPORT:
+    case ORDER_CONVOY: {
+      const char* dash = order.type == ORDER_SUPPORT ? "6 3" : "2 4";
+      anchor(map, order.unit, &x1, &y1);
+      double fromX, fromY;
+      anchor(map, Location{order.from, board.units[order.from].coast}, &fromX, &fromY);
+      if (order.to.province == order.from) {
+        // Support to hold ends on the supported unit, without a head
+        AppendArrow(x1, y1, fromX, fromY, colour, dash, false, failed);
+        break;
+      }
+      // Support or convoy for a move points into the supported arrow
+      anchor(map, order.to, &x2, &y2);
+      double along = order.type == ORDER_SUPPORT ? 0.6 : 0.5;
+      double targetX = fromX + (x2 - fromX) * along;
+      double targetY = fromY + (y2 - fromY) * along;
+      AppendArrow(x1, y1, targetX, targetY, colour, dash, true, failed);
+      break;
+    }
+    case ORDER_BUILD:
+      anchor(map, order.unit, &x1, &y1);
+      AppendUnit(x1, y1, order.unitType, colour, false);
+      buffer_ += "<circle cx=\"";
+      AppendNumber(x1);
+      buffer_ += "\" cy=\"";
+      AppendNumber(y1);
+      buffer_ += "\" r=\"17\" fill=\"none\" stroke=\"" + colour +
+                 "\" stroke-width=\"2\" stroke-dasharray=\"4 3\"/>\n";
+      break;
+    case ORDER_REMOVE:
+      anchor(map, order.unit, &x1, &y1);
+      AppendCross(x1, y1);
+      break;
+    case ORDER_DISBAND:
+      anchor(map, order.unit, &x1, &y1);
+      AppendCross(x1 + kDislodgedOffset, y1 + kDislodgedOffset);
+      break;
+    case ORDER_HOLD:
+    case ORDER_WAIVE:
+      break;
+  }
+}
+
+// Phase name in the corner, and a strip below the map with each power's
+// colour and its supply centers and units
+void MapRenderer::DrawLegend(const Board& board) {
+  const Map& map = board.GetMap();
+  buffer_ += "<text x=\"16\" y=\"32\" font-size=\"22\">";
+  buffer_ += kSeasonNames[board.season];
+  buffer_ += ' ';
+  AppendNumber(board.year);
+  buffer_ += ' ';
+  buffer_ += kPhaseNames[board.phase];
+  buffer_ += "</text>\n";
+
+  int rows = (map.PowerCount() + kLegendColumns - 1) / kLegendColumns;
+  buffer_ += "<rect y=\"";
+  AppendNumber(kMapHeight);
+  buffer_ += "\" width=\"";
+  AppendNumber(kMapWidth);
+  buffer_ += "\" height=\"";
+  AppendNumber(rows * kLegendRow + 16);
+  buffer_ += "\" fill=\"#fff\"/>\n<g font-size=\"13\">\n";
+  double columnWidth = static_cast<double>(kMapWidth) / kLegendColumns;
+  for (int power = 0; power < map.PowerCount(); ++power) {
+    double x = 16 + (power % kLegendColumns) * columnWidth;
+    double y = kMapHeight + 12 + (power / kLegendColumns) * kLegendRow;
+    buffer_ += "<rect x=\"";
+    AppendNumber(x);
+    buffer_ += "\" y=\"";
+    AppendNumber(y);
+    buffer_ += "\" width=\"14\" height=\"14\" fill=\"" + PowerColour(map, power) + "\"/><text x=\"";
+    AppendNumber(x + 20);
+    buffer_ += "\" y=\"";
+    AppendNumber(y + 12);
+    buffer_ += "\">" + map.PowerName(power) + ' ';
+    AppendNumber(board.CenterCount(power));
+    buffer_ += '/';
+    AppendNumber(board.UnitCount(power));
+    buffer_ += "</text>\n";
+  }
+  buffer_ += "</g>\n";
+}
+
+// An army is a square and a fleet a flattened oval, lettered; a dislodged
+// unit gets a red outline
+void MapRenderer::AppendUnit(double x, double y, UnitType type, const std::string& colour, bool dislodged) {
+  const char* stroke = dislodged ? "#e00" : "#222";
+  if (type == UNIT_ARMY) {
+    buffer_ += "<rect x=\"";
+    AppendNumber(x - 10);
+    buffer_ += "\" y=\"";
+    AppendNumber(y - 8);
+    buffer_ += "\" width=\"20\" height=\"16\" rx=\"3\"";
+  } else {
+    buffer_ += "<ellipse cx=\"";
+    AppendNumber(x);
+    buffer_ += "\" cy=\"";
+    AppendNumber(y);
+    buffer_ += "\" rx=\"12\" ry=\"8\"";
+  }
+  buffer_ += " fill=\"" + colour + "\" stroke=\"" + stroke + "\" stroke-width=\"" +
+             (dislodged ? "2.5" : "1") + "\"/><text x=\"";
+  AppendNumber(x);
+  buffer_ += "\" y=\"";
+  AppendNumber(y + 4);
+  buffer_ += "\" font-size=\"11\" font-weight=\"bold\" fill=\"#fff\" text-anchor=\"middle\">";
+  buffer_ += type == UNIT_ARMY ? 'A' : 'F';
+  buffer_ += "</text>\n";
+}
+
+// A line between two points, pulled back clear of the unit at the start
+// and of the province marker at the end, with an arrowhead or a dot
+void MapRenderer::AppendArrow(double x1, double y1, double x2, double y2, const std::string& colour,
+                              const char* dash, bool head, bool failed) {
+  double dx = x2 - x1;
+  double dy = y2 - y1;
+  double length = std::sqrt(dx * dx + dy * dy);
+  if (length < 2 * kProvinceRadius) {
+    return;
+  }
+  dx /= length;
+  dy /= length;
+  x1 += dx * kProvinceRadius;
+  y1 += dy * kProvinceRadius;
+  x2 -= dx * kProvinceRadius;
+  y2 -= dy * kProvinceRadius;
+
+  buffer_ += "<g stroke=\"" + colour + "\" fill=\"" + colour + "\"";
+  if (failed) {
+    buffer_ += " opacity=\"0.4\"";
+  }
+  buffer_ += "><line x1=\"";
+  AppendNumber(x1);
+  buffer_ += "\" y1=\"";
+  AppendNumber(y1);
+  buffer_ += "\" x2=\"";
+  AppendNumber(x2);
+  buffer_ += "\" y2=\"";
+  AppendNumber(y2);
+  buffer_ += "\" stroke-width=\"";
+  buffer_ += dash ? "2" : "3";
+  buffer_ += '"';
+  if (dash) {
+    buffer_ += " stroke-dasharray=\"";
+    buffer_ += dash;
+    buffer_ += '"';
+  }
+  buffer_ += "/>";
+  if (head) {
+    buffer_ += "<polygon stroke-width=\"1\" points=\"";
+    AppendNumber(x2);
+    buffer_ += ',';
+    AppendNumber(y2);
+    buffer_ += ' ';
+    AppendNumber(x2 - dx * 11 + dy * 5);
+    buffer_ += ',';
+    AppendNumber(y2 - dy * 11 - dx * 5);
+    buffer_ += ' ';
+    AppendNumber(x2 - dx * 11 - dy * 5);
+    buffer_ += ',';
+    AppendNumber(y2 - dy * 11 + dx * 5);
+    buffer_ += "\"/>";
+  } else {
+    buffer_ += "<circle r=\"4\" cx=\"";
+    AppendNumber(x2);
+    buffer_ += "\" cy=\"";
+    AppendNumber(y2);
+    buffer_ += "\"/>";
+  }
+  buffer_ += "</g>\n";
+}
+
+void MapRenderer::AppendCross(double x, double y) {
+  buffer_ += "<path stroke=\"#e00\" stroke-width=\"3\" d=\"M";
+  AppendNumber(x - 9);
+  buffer_ += ' ';
+  AppendNumber(y - 9);
+  buffer_ += "l18 18m0 -18l-18 18\"/>\n";
+}
+
+// Coordinates to a tenth of a pixel, without trailing zeros
+void MapRenderer::AppendNumber(double value) {
+  char text[32];
+  int length = snprintf(text, sizeof text, "%.1f", value);
+  if (length > 2 && text[length - 1] == '0' && text[length - 2] == '.') {
+    length -= 2;
+  }
+  buffer_.append(text, length);
+}
+
+}  // namespace diplomacy
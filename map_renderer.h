@@ -0,0 +1,51 @@
+#ifndef MAP_RENDERER_H
+#define MAP_RENDERER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "adjudicator.h"
+
+namespace diplomacy {
+
+// Draws a board as an SVG picture: the provinces and the links between
+// neighbours, supply center ownership, the units, and a phase's orders as
+// arrows in their power's colour, faded where they failed.
+//
+// The base layer -- provinces, links and supply centers -- never changes
+// during a game, so it is drawn once per map and shared by every renderer;
+// a picture only draws the overlay for its own phase on top. Like
+// ReportWriter, a renderer keeps its buffer between pictures.
+class MapRenderer {
+ public:
+  MapRenderer() {}
+
+  // `board` with `orders` as resolved from it; no orders draws just the
+  // position. The text stays valid until the next call.
+  const std::string& Render(const Board& board, const std::vector<ResolvedOrder>& orders);
+
+  // The base layer of `map` as an SVG group, built on first use
+  static std::shared_ptr<const std::string> BaseLayer(const Map& map);
+
+ private:
+  void DrawOwnership(const Board& board);
+  void DrawUnits(const Board& board, const std::vector<ResolvedOrder>& orders);
+  void DrawOrder(const Board& board, const ResolvedOrder& resolved);
+  void DrawLegend(const Board& board);
+
+  void AppendUnit(double x, double y, UnitType type, const std::string& colour, bool dislodged);
+  void AppendArrow(double x1, double y1, double x2, double y2, const std::string& colour,
+                   const char* dash, bool head, bool failed);
+  void AppendCross(double x, double y);
+  void AppendNumber(double value);
+
+  std::string buffer_;
+};
+
+// Fill colour for a power: the usual colours on the standard map, and
+// evenly spread hues for the powers of other variants
+std::string PowerColour(const Map& map, int power);
+
+}  // namespace diplomacy
+
+#endif // MAP_RENDERER_H
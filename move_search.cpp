@@ -0,0 +1,324 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <random>
+#include <system_error>
+#include <thread>
+#include "move_search.h"
+
+namespace diplomacy {
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+Order makeOrder(OrderType type, int power, UnitType unitType, const Location& unit,
+                ProvinceId from = NO_PROVINCE,
+                const Location& to = Location{NO_PROVINCE, COAST_NONE}) {
+  return Order{type, power, unitType, unit, from, to, false};
+}
+
+void movementOptions(const Board& board, int power, std::vector<UnitOptions>* options) {
+  const Map& map = board.GetMap();
+  for (ProvinceId p = 0; p < map.ProvinceCount(); ++p) {
+    const Unit& unit = board.units[p];
+    if (unit.power != power) {
+      continue;
+    }
+    Location at{p, unit.coast};
+    UnitOptions unitOptions;
+    unitOptions.orders.push_back(makeOrder(ORDER_HOLD, power, unit.type, at));
+    for (const Location& to : map.Neighbours(unit.type, at)) {
+      unitOptions.orders.push_back(makeOrder(ORDER_MOVE, power, unit.type, at, NO_PROVINCE, to));
+    }
+    unitOptions.moves = unitOptions.orders.size() - 1;
+
+    // Support for any unit, of any power, that holds or moves where this one reaches
+    for (ProvinceId q = 0; q < map.ProvinceCount(); ++q) {
+      const Unit& other = board.units[q];
+      if (q == p || other.power < 0) {
+        continue;
+      }
+      if (map.CanReach(unit.type, at, q)) {
+        unitOptions.orders.push_back(
+            makeOrder(ORDER_SUPPORT, power, unit.type, at, q, Location{q, COAST_NONE}));
+      }
+      for (const Location& to : map.Neighbours(other.type, Location{q, other.coast})) {
+        if (to.province != p && map.CanReach(unit.type, at, to.province)) {
+          unitOptions.orders.push_back(makeOrder(ORDER_SUPPORT, power, unit.type, at, q,
+                                                 Location{to.province, COAST_NONE}));
+        }
+      }
+    }
+    options->push_back(std::move(unitOptions));
+  }
+}
+
+void retreatOptions(const Board& board, int power, std::vector<UnitOptions>* options) {
+  for (const DislodgedUnit& unit : board.dislodged) {
+    if (unit.power != power) {
+      continue;
+    }
+    UnitOptions unitOptions;
+    unitOptions.orders.push_back(makeOrder(ORDER_DISBAND, power, unit.type, unit.location));
+    for (const Location& to : unit.retreats) {
+      unitOptions.orders.push_back(
+          makeOrder(ORDER_RETREAT, power, unit.type, unit.location, NO_PROVINCE, to));
+    }
+    unitOptions.moves = unit.retreats.size();
+    options->push_back(std::move(unitOptions));
+  }
+}
+
+void adjustmentOptions(const Board& board, int power, std::vector<UnitOptions>* options) {
+  const Map& map = board.GetMap();
+  int due = board.AdjustmentCount(power);
+  UnitOptions slot;
+  if (due > 0) {
+    slot.orders.push_back(makeOrder(ORDER_WAIVE, power, UNIT_ARMY, Location{NO_PROVINCE, COAST_NONE}));
+    int sites = 0;
+    for (ProvinceId p = 0; p < map.ProvinceCount(); ++p) {
+      if (!CanBuild(board, power, p)) {
+        continue;
+      }
+      const Province& province = map.GetProvince(p);
+      sites++;
+      if (map.CanOccupy(UNIT_ARMY, Location{p, COAST_NONE})) {
+        slot.orders.push_back(makeOrder(ORDER_BUILD, power, UNIT_ARMY, Location{p, COAST_NONE}));
+      }
+      if (province.coasts.empty()) {
+        if (map.CanOccupy(UNIT_FLEET, Location{p, COAST_NONE})) {
+          slot.orders.push_back(makeOrder(ORDER_BUILD, power, UNIT_FLEET, Location{p, COAST_NONE}));
+        }
+      } else {
+        for (Coast coast : province.coasts) {
+          slot.orders.push_back(makeOrder(ORDER_BUILD, power, UNIT_FLEET, Location{p, coast}));
+        }
+      }
+    }
+    due = std::min(due, sites);
+  } else if (due < 0) {
+    for (ProvinceId p = 0; p < map.ProvinceCount(); ++p) {
+      const Unit& unit = board.units[p];
+      if (unit.power == power) {
+        slot.orders.push_back(makeOrder(ORDER_REMOVE, power, unit.type, Location{p, unit.coast}));
+      }
+    }
+    due = -due;
+  }
+  for (int i = 0; i < due; ++i) {
+    options->push_back(slot);
+  }
+}
+
+// Hold now and then, otherwise move rather than support
+const Order& sampleOrder(const UnitOptions& options, std::mt19937_64& rng) {
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  size_t count = options.orders.size();
+  size_t supports = count - 1 - options.moves;
+  double r = uniform(rng);
+  if (r < 0.15 || count == 1) {
+    return options.orders[0];
+  }
+  if ((r < 0.65 && options.moves > 0) || supports == 0) {
+    return options.orders[1 + rng() % options.moves];
+  }
+  return options.orders[1 + options.moves + rng() % supports];
+}
+
+// No two builds in one province and no unit removed twice; the spare
+// build slots are waived and spare removals taken by the next free unit
+void dedupeAdjustments(const std::vector<UnitOptions>& options, std::vector<Order>* orders) {
+  std::vector<ProvinceId> used;
+  for (size_t i = 0; i < orders->size(); ++i) {
+    Order& order = (*orders)[i];
+    if (order.type == ORDER_WAIVE) {
+      continue;
+    }
+    if (std::find(used.begin(), used.end(), order.unit.province) == used.end()) {
+      used.push_back(order.unit.province);
+      continue;
+    }
+    if (order.type == ORDER_BUILD) {
+      order = options[i].orders[0];
+      continue;
+    }
+    for (const Order& other : options[i].orders) {
+      if (std::find(used.begin(), used.end(), other.unit.province) == used.end()) {
+        order = other;
+        used.push_back(other.unit.province);
+        break;
+      }
+    }
+  }
+}
+
+std::vector<Order> sampleOrders(const Board& board, const std::vector<UnitOptions>& options,
+                                std::mt19937_64& rng) {
+  std::vector<Order> orders;
+  orders.reserve(options.size());
+  for (const UnitOptions& unit : options) {
+    orders.push_back(sampleOrder(unit, rng));
+  }
+  if (board.phase == PHASE_ADJUSTMENT) {
+    dedupeAdjustments(options, &orders);
+  }
+  return orders;
+}
+
+// Centers held, units kept and supply centers under threat after the phase
+double evaluate(const Board& board, int power) {
+  const Map& map = board.GetMap();
+  double score = 10.0 * board.CenterCount(power);
+  for (ProvinceId p = 0; p < map.ProvinceCount(); ++p) {
+    const Unit& unit = board.units[p];
+    const Province& province = map.GetProvince(p);
+    if (unit.power < 0) {
+      continue;
+    }
+    if (unit.power != power) {
+      // An enemy standing in one of our centers takes it at the end of the year
+      if (province.supplyCenter && board.owners[p] == power) {
+        score -= 4.0;
+      }
+      continue;
+    }
+    score += 2.0;
+    if (province.supplyCenter && board.owners[p] != power) {
+      score += 4.0;
+    }
+    for (const Location& to : map.Neighbours(unit.type, Location{p, unit.coast})) {
+      const Province& next = map.GetProvince(to.province);
+      if (next.supplyCenter && board.owners[to.province] != power) {
+        score += 0.5;
+      }
+    }
+  }
+  for (const DislodgedUnit& unit : board.dislodged) {
+    if (unit.power == power) {
+      score -= unit.retreats.empty() ? 2.0 : 1.0;
+    }
+  }
+  return score;
+}
+
+struct Candidate {
+  std::vector<Order> orders;
+  double score = -std::numeric_limits<double>::infinity();
+};
+
+}  // namespace
+
+std::vector<UnitOptions> LegalOrders(const Board& board, int power) {
+  std::vector<UnitOptions> options;
+  switch (board.phase) {
+    case PHASE_MOVEMENT:
+      movementOptions(board, power, &options);
+      break;
+    case PHASE_RETREAT:
+      retreatOptions(board, power, &options);
+      break;
+    case PHASE_ADJUSTMENT:
+      adjustmentOptions(board, power, &options);
+      break;
+  }
+  return options;
+}
+
+SearchResult SearchOrders(const Board& board, int power, const SearchOptions& options) {
+  SearchResult result;
+  std::vector<UnitOptions> units = LegalOrders(board, power);
+  if (units.empty()) {
+    return result;
+  }
+
+  // Every candidate meets the same sampled orders for the other powers, so
+  // that scores compare candidates rather than luck
+  std::mt19937_64 rng(options.seed);
+  std::vector<std::vector<UnitOptions>> others;
+  for (int other = 0; other < board.GetMap().PowerCount(); ++other) {
+    if (other != power) {
+      others.push_back(LegalOrders(board, other));
+    }
+  }
+  std::vector<std::vector<Order>> scenarios(std::max(1, options.scenarios));
+  for (auto& scenario : scenarios) {
+    for (const auto& other : others) {
+      std::vector<Order> orders = sampleOrders(board, other, rng);
+      scenario.insert(scenario.end(), orders.begin(), orders.end());
+    }
+  }
+
+  int hardware = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  int threads = options.threads > 0 ? std::min(options.threads, hardware) : hardware;
+  Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(options.timeBudgetMs);
+  std::atomic<uint64_t> evaluations(0);
+  std::vector<Candidate> best(threads);
+
+  auto search = [&](int index) {
+    std::mt19937_64 threadRng(options.seed + 0x9E3779B97F4A7C15ULL * (index + 1));
+    Board scratch = board;
+    PhaseResult phaseResult;
+    std::vector<Order> orders;
+    Candidate& mine = best[index];
+    do {
+      // Fresh samples explore; changing one order of the best so far refines
+      std::vector<Order> candidate;
+      if (mine.orders.empty() || threadRng() % 4 == 0) {
+        candidate = sampleOrders(board, units, threadRng);
+      } else {
+        candidate = mine.orders;
+        size_t slot = threadRng() % units.size();
+        candidate[slot] = sampleOrder(units[slot], threadRng);
+        if (board.phase == PHASE_ADJUSTMENT) {
+          dedupeAdjustments(units, &candidate);
+        }
+      }
+
+      double total = 0;
+      for (const auto& scenario : scenarios) {
+        orders.assign(candidate.begin(), candidate.end());
+        orders.insert(orders.end(), scenario.begin(), scenario.end());
+        scratch = board;
+        Adjudicate(&scratch, orders, &phaseResult);
+        total += evaluate(scratch, power);
+      }
+      evaluations += scenarios.size();
+      double score = total / scenarios.size();
+      if (score > mine.score) {
+        mine.orders = std::move(candidate);
+        mine.score = score;
+      }
+    } while (Clock::now() < deadline);
+  };
+
+  // Go on with the threads that started if the system will not give more
+  std::vector<std::thread> pool;
+  for (int i = 1; i < threads; ++i) {
+    try {
+      pool.emplace_back(search, i);
+    } catch (const std::system_error&) {
+      threads = i;
+      break;
+    }
+  }
+  search(0);
+  for (auto& thread : pool) {
+    thread.join();
+  }
+
+  const Candidate* winner = &best[0];
+  for (int i = 1; i < threads; ++i) {
+    if (best[i].score > winner->score) {
+      winner = &best[i];
+    }
+  }
+  result.orders = winner->orders;
+  result.score = winner->score;
+  result.evaluations = evaluations;
+  result.threads = threads;
+  return result;
+}
+
+}  // namespace diplomacy
@@ -0,0 +1,48 @@
+#ifndef MOVE_SEARCH_H
+#define MOVE_SEARCH_H
+
+#include <cstdint>
+#include <vector>
+#include "adjudicator.h"
+
+namespace diplomacy {
+
+// Every order one unit (or one build or removal) could be given, in the
+// phase the board is in. For units, orders[0] holds or disbands, the next
+// `moves` orders move or retreat and the rest support. Convoys are not
+// generated.
+struct UnitOptions {
+  std::vector<Order> orders;
+  size_t moves = 0;
+};
+
+// Options for each unit of `power` that needs an order this phase. In the
+// adjustment phase there is one entry per build or removal due, each
+// listing every build or removal open to the power.
+std::vector<UnitOptions> LegalOrders(const Board& board, int power);
+
+struct SearchOptions {
+  int threads = 0;              // 0 for one per hardware thread, and never more
+  int timeBudgetMs = 100;
+  int scenarios = 8;            // Sampled opponent order sets per candidate
+  uint64_t seed = 0;
+};
+
+struct SearchResult {
+  std::vector<Order> orders;
+  double score = 0;             // Mean evaluation over the scenarios
+  uint64_t evaluations = 0;     // Adjudications run, across all threads
+  int threads = 0;
+};
+
+// Monte Carlo search for `power`'s orders on `board`. Candidate order sets
+// are sampled and locally improved on every thread until the time budget
+// runs out; each is adjudicated against the same sampled orders for the
+// other powers and scored by the position it leaves. At least one
+// candidate is tried per thread, however short the budget. If the system
+// cannot start every thread asked for, the search runs on those it could.
+SearchResult SearchOrders(const Board& board, int power, const SearchOptions& options);
+
+}  // namespace diplomacy
+
+#endif // MOVE_SEARCH_H
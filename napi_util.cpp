@@ -0,0 +1,231 @@
+#include "napi_util.h"
+
+#include <algorithm>
+#include <cstring>
+#ifndef _WIN32
+#include <dlfcn.h>
+#endif
+
+namespace diplomacy {
+
+namespace {
+
+// node_api_create_external_string_latin1, from Node-API 10
+typedef napi_status (*CreateExternalLatin1)(napi_env env, char* str, size_t length,
+                                            napi_finalize finalize, void* hint,
+                                            napi_value* result, bool* copied);
+
+CreateExternalLatin1 createExternalLatin1() {
+#ifndef _WIN32
+  static const CreateExternalLatin1 create = reinterpret_cast<CreateExternalLatin1>(
+      dlsym(RTLD_DEFAULT, "node_api_create_external_string_latin1"));
+  return create;
+#else
+  return nullptr;
+#endif
+}
+
+void releaseShared(napi_env env, void* data, void* hint) {
+  delete static_cast<std::shared_ptr<const std::string>*>(hint);
+}
+
+}  // namespace
+
+CallbackArgs::CallbackArgs(napi_env env, napi_callback_info info)
+    : length_(kMaxArgs), data_(nullptr) {
+  napi_get_cb_info(env, info, &length_, args_, nullptr, &data_);
+  napi_get_undefined(env, &undefined_);
+}
+
+std::string ToString(napi_env env, napi_value value) {
+  napi_value text;
+  size_t length = 0;
+  if (napi_coerce_to_string(env, value, &text) != napi_ok ||
+      napi_get_value_string_utf8(env, text, nullptr, 0, &length) != napi_ok) {
+    return "";
+  }
+  std::string result(length, '\0');
+  napi_get_value_string_utf8(env, text, &result[0], length + 1, &length);
+  return result;
+}
+
+int32_t ToInt32(napi_env env, napi_value value) {
+  napi_value number;
+  int32_t result = 0;
+  if (napi_coerce_to_number(env, value, &number) == napi_ok) {
+    napi_get_value_int32(env, number, &result);
+  }
+  return result;
+}
+
+double ToNumber(napi_env env, napi_value value) {
+  napi_value number;
+  double result = 0;
+  if (napi_coerce_to_number(env, value, &number) == napi_ok) {
+    napi_get_value_double(env, number, &result);
+  }
+  return result;
+}
+
+bool ToBoolean(napi_env env, napi_value value) {
+  napi_value boolean;
+  bool result = false;
+  if (napi_coerce_to_bool(env, value, &boolean) == napi_ok) {
+    napi_get_value_bool(env, boolean, &result);
+  }
+  return result;
+}
+
+namespace {
+
+napi_valuetype typeOf(napi_env env, napi_value value) {
+  napi_valuetype type = napi_undefined;
+  napi_typeof(env, value, &type);
+  return type;
+}
+
+}  // namespace
+
+bool IsUndefined(napi_env env, napi_value value) {
+  return typeOf(env, value) == napi_undefined;
+}
+
+bool IsNull(napi_env env, napi_value value) {
+  return typeOf(env, value) == napi_null;
+}
+
+bool IsNumber(napi_env env, napi_value value) {
+  return typeOf(env, value) == napi_number;
+}
+
+bool IsString(napi_env env, napi_value value) {
+  return typeOf(env, value) == napi_string;
+}
+
+bool IsObject(napi_env env, napi_value value) {
+  napi_valuetype type = typeOf(env, value);
+  return type == napi_object || type == napi_function;
+}
+
+bool IsArray(napi_env env, napi_value value) {
+  bool result = false;
+  napi_is_array(env, value, &result);
+  return result;
+}
+
+napi_value NewString(napi_env env, const std::string& text) {
+  napi_value result;
+  napi_create_string_utf8(env, text.data(), text.size(), &result);
+  return result;
+}
+
+napi_value NewSharedString(napi_env env, const std::shared_ptr<const std::string>& text) {
+  CreateExternalLatin1 create = createExternalLatin1();
+  bool ascii = std::all_of(text->begin(), text->end(),
+                           [](char c) { return static_cast<unsigned char>(c) < 0x80; });
+  if (!create || !ascii) {
+    return NewString(env, *text);
+  }
+
+  // The string holds a reference to the text; if the runtime copies it
+  // instead, it has already run the finalizer
+  auto* hold = new std::shared_ptr<const std::string>(text);
+  napi_value result;
+  bool copied = false;
+  if (create(env, const_cast<char*>(text->data()), text->size(), releaseShared, hold,
+             &result, &copied) != napi_ok) {
+    delete hold;
+    return NewString(env, *text);
+  }
+  return result;
+}
+
+napi_value NewNumber(napi_env env, double value) {
+  napi_value result;
+  napi_create_double(env, value, &result);
+  return result;
+}
+
+napi_value NewBoolean(napi_env env, bool value) {
+  napi_value result;
+  napi_get_boolean(env, value, &result);
+  return result;
+}
+
+napi_value Null(napi_env env) {
+  napi_value result;
+  napi_get_null(env, &result);
+  return result;
+}
+
+napi_value NewObject(napi_env env) {
+  napi_value result;
+  napi_create_object(env, &result);
+  return result;
+}
+
+napi_value NewArray(napi_env env, size_t length) {
+  napi_value result;
+  napi_create_array_with_length(env, length, &result);
+  return result;
+}
+
+void SetProperty(napi_env env, napi_value object, const char* key, napi_value value) {
+  napi_set_named_property(env, object, key, value);
+}
+
+napi_value GetProperty(napi_env env, napi_value object, const char* key) {
+  napi_value result = nullptr;
+  if (napi_get_named_property(env, object, key, &result) != napi_ok) {
+    napi_get_undefined(env, &result);
+  }
+  return result;
+}
+
+void SetElement(napi_env env, napi_value array, uint32_t index, napi_value value) {
+  napi_set_element(env, array, index, value);
+}
+
+napi_value GetElement(napi_env env, napi_value array, uint32_t index) {
+  napi_value result = nullptr;
+  if (napi_get_element(env, array, index, &result) != napi_ok) {
+    napi_get_undefined(env, &result);
+  }
+  return result;
+}
+
+uint32_t ArrayLength(napi_env env, napi_value array) {
+  uint32_t length = 0;
+  napi_get_array_length(env, array, &length);
+  return length;
+}
+
+napi_value ThrowTypeError(napi_env env, const char* message) {
+  napi_throw_type_error(env, nullptr, message);
+  return nullptr;
+}
+
+bool TypedArrayContents(napi_env env, napi_value value, napi_typedarray_type type,
+                        void** data, size_t* length) {
+  bool typed = false;
+  napi_typedarray_type actual;
+  if (napi_is_typedarray(env, value, &typed) != napi_ok || !typed ||
+      napi_get_typedarray_info(env, value, &actual, length, data, nullptr, nullptr) != napi_ok) {
+    return false;
+  }
+  return actual == type;
+}
+
+napi_value NewInt32Array(napi_env env, const std::vector<int32_t>& values) {
+  void* data = nullptr;
+  napi_value buffer;
+  napi_value result;
+  napi_create_arraybuffer(env, values.size() * sizeof(int32_t), &data, &buffer);
+  if (!values.empty()) {
+    std::memcpy(data, values.data(), values.size() * sizeof(int32_t));
+  }
+  napi_create_typedarray(env, napi_int32_array, values.size(), buffer, 0, &result);
+  return result;
+}
+
+}  // namespace diplomacy
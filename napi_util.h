@@ -0,0 +1,81 @@
+#ifndef NAPI_UTIL_H
+#define NAPI_UTIL_H
+
+#include <node_api.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace diplomacy {
+
+// Small helpers over the Node-API C interface for the binding's exports.
+// Reading a value converts it the way JavaScript would (String(x),
+// Number(x) | 0, !!x), as the exports always have. A Node-API call that
+// fails leaves a JavaScript exception pending, which surfaces once the
+// export returns.
+
+// The arguments of one call; those not passed read as undefined
+class CallbackArgs {
+ public:
+  CallbackArgs(napi_env env, napi_callback_info info);
+
+  size_t Length() const { return length_; }
+  napi_value operator[](size_t index) const { return index < kMaxArgs ? args_[index] : undefined_; }
+
+  // The pointer the export was registered with
+  void* Data() const { return data_; }
+
+ private:
+  static const size_t kMaxArgs = 8;
+
+  size_t length_;
+  napi_value args_[kMaxArgs];
+  napi_value undefined_;
+  void* data_;
+};
+
+std::string ToString(napi_env env, napi_value value);
+int32_t ToInt32(napi_env env, napi_value value);
+double ToNumber(napi_env env, napi_value value);
+bool ToBoolean(napi_env env, napi_value value);
+
+bool IsUndefined(napi_env env, napi_value value);
+bool IsNull(napi_env env, napi_value value);
+bool IsNumber(napi_env env, napi_value value);
+bool IsString(napi_env env, napi_value value);
+bool IsObject(napi_env env, napi_value value);  // Arrays and functions included
+bool IsArray(napi_env env, napi_value value);
+
+napi_value NewString(napi_env env, const std::string& text);
+
+// A string over `text` without copying it, kept alive until the string is
+// collected. This needs external strings (node_api_create_external_string_latin1,
+// looked up at load since the binding targets an older Node-API); without
+// them, or for text that is not plain ASCII, the text is copied.
+napi_value NewSharedString(napi_env env, const std::shared_ptr<const std::string>& text);
+napi_value NewNumber(napi_env env, double value);
+napi_value NewBoolean(napi_env env, bool value);
+napi_value Null(napi_env env);
+napi_value NewObject(napi_env env);
+napi_value NewArray(napi_env env, size_t length = 0);
+
+void SetProperty(napi_env env, napi_value object, const char* key, napi_value value);
+napi_value GetProperty(napi_env env, napi_value object, const char* key);
+void SetElement(napi_env env, napi_value array, uint32_t index, napi_value value);
+napi_value GetElement(napi_env env, napi_value array, uint32_t index);
+uint32_t ArrayLength(napi_env env, napi_value array);
+
+// Throw a TypeError; returns the null handle for the export to return
+napi_value ThrowTypeError(napi_env env, const char* message);
+
+// The elements of a typed array of `type`, in place; false if `value` is
+// anything else
+bool TypedArrayContents(napi_env env, napi_value value, napi_typedarray_type type,
+                        void** data, size_t* length);
+
+napi_value NewInt32Array(napi_env env, const std::vector<int32_t>& values);
+
+}  // namespace diplomacy
+
+#endif // NAPI_UTIL_H
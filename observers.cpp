@@ -0,0 +1,100 @@
+#include <algorithm>
+#include "observers.h"
+
+namespace diplomacy {
+
+void ObserverRegistry::Subscribe(const std::string& address, int delayPhases) {
+  int delay = std::max(delayPhases, 0);
+  auto it = delays_.find(address);
+  if (it != delays_.end()) {
+    if (it->second == delay) {
+      return;
+    }
+    Unsubscribe(address);
+  }
+  delays_[address] = delay;
+  std::vector<std::string>& members = members_[delay];
+  members.insert(std::lower_bound(members.begin(), members.end(), address), address);
+  Rebuild(delay);
+}
+
+bool ObserverRegistry::Unsubscribe(const std::string& address) {
+  auto it = delays_.find(address);
+  if (it == delays_.end()) {
+    return false;
+  }
+  int delay = it->second;
+  delays_.erase(it);
+  std::vector<std::string>& members = members_[delay];
+  members.erase(std::lower_bound(members.begin(), members.end(), address));
+  Rebuild(delay);
+  return true;
+}
+
+int ObserverRegistry::Delay(const std::string& address) const {
+  auto it = delays_.find(address);
+  return it != delays_.end() ? it->second : -1;
+}
+
+// Snapshot a group's members after a change; deliveries already handed
+// out keep the list they were made with
+void ObserverRegistry::Rebuild(int delay) {
+  std::vector<std::string>& members = members_[delay];
+  if (members.empty()) {
+    members_.erase(delay);
+    groups_.erase(delay);
+    Trim();
+    return;
+  }
+  auto group = groups_.find(delay);
+  if (group == groups_.end()) {
+    group = groups_.emplace(delay, Group{nullptr, nextSeq_}).first;
+  }
+  group->second.addresses = std::make_shared<const std::vector<std::string>>(members);
+}
+
+std::vector<ViewDelivery> ObserverRegistry::Publish(const std::string& phase,
+                                                    const std::string& subject,
+                                                    std::shared_ptr<const std::string> body) {
+  if (views_.empty() || views_.back().view->phase != phase) {
+    phaseCount_++;
+  }
+  auto view = std::make_shared<PublicView>();
+  view->phase = phase;
+  view->subject = subject;
+  view->body = std::move(body);
+  views_.push_back({nextSeq_++, phaseCount_ - 1, std::move(view)});
+
+  // Each group takes, in order, the views at least `delay` phases behind
+  // the latest; the rest wait for later phases
+  std::vector<ViewDelivery> deliveries;
+  for (auto& pair : groups_) {
+    int delay = pair.first;
+    Group& group = pair.second;
+    for (const StoredView& stored : views_) {
+      if (stored.seq < group.next) {
+        continue;
+      }
+      if (stored.phaseIndex + delay >= phaseCount_) {
+        break;
+      }
+      deliveries.push_back({group.addresses, stored.view});
+      group.next = stored.seq + 1;
+    }
+  }
+  Trim();
+  return deliveries;
+}
+
+// Drop views every group has had
+void ObserverRegistry::Trim() {
+  uint64_t oldest = nextSeq_;
+  for (const auto& pair : groups_) {
+    oldest = std::min(oldest, pair.second.next);
+  }
+  while (!views_.empty() && views_.front().seq < oldest) {
+    views_.pop_front();
+  }
+}
+
+}  // namespace diplomacy
@@ -0,0 +1,79 @@
+#ifndef OBSERVERS_H
+#define OBSERVERS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace diplomacy {
+
+// Something every watcher of a game sees alike: a phase's results and
+// position, or broadcast press. It is rendered once and shared by every
+// delivery.
+struct PublicView {
+  std::string phase;       // "S1901M", the phase it belongs to
+  std::string subject;
+  std::shared_ptr<const std::string> body;
+};
+
+// One view released to a group of watchers. The address list is a shared
+// snapshot, so a delivery costs the same for one watcher or thousands.
+struct ViewDelivery {
+  std::shared_ptr<const std::vector<std::string>> addresses;
+  std::shared_ptr<const PublicView> view;
+};
+
+// The observers of one game. Watchers are grouped by delay: live observers
+// (delay 0) get each view as it is published; delayed spectators get it
+// once views from `delay` later phases have been published. Views are kept
+// only until every group has had them.
+class ObserverRegistry {
+ public:
+  ObserverRegistry() {}
+
+  // Watch the game, or change the delay of an existing watcher. A new
+  // group starts with the next view published.
+  void Subscribe(const std::string& address, int delayPhases);
+  bool Unsubscribe(const std::string& address);
+
+  // Delay of a watcher, or -1 if not watching
+  int Delay(const std::string& address) const;
+  size_t Count() const { return delays_.size(); }
+
+  // Addresses and their delays, by address
+  const std::map<std::string, int>& Watchers() const { return delays_; }
+
+  // Add a view and return the deliveries it releases
+  std::vector<ViewDelivery> Publish(const std::string& phase, const std::string& subject,
+                                    std::shared_ptr<const std::string> body);
+
+ private:
+  struct Group {
+    std::shared_ptr<const std::vector<std::string>> addresses;
+    uint64_t next;          // Sequence number of the next view to deliver
+  };
+
+  struct StoredView {
+    uint64_t seq;
+    uint64_t phaseIndex;    // Count of distinct phases before this view's
+    std::shared_ptr<const PublicView> view;
+  };
+
+  void Rebuild(int delay);
+  void Trim();
+
+  std::map<std::string, int> delays_;
+  std::map<int, std::vector<std::string>> members_;
+  std::map<int, Group> groups_;
+  std::deque<StoredView> views_;
+  uint64_t nextSeq_ = 0;
+  uint64_t phaseCount_ = 0;   // Distinct phases published so far
+};
+
+}  // namespace diplomacy
+
+#endif // OBSERVERS_H
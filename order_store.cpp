@@ -0,0 +1,93 @@
+#include <algorithm>
+#include "order_store.h"
+
+namespace diplomacy {
+
+namespace {
+
+// The province an order is keyed on; waives share NO_PROVINCE
+ProvinceId orderedUnit(const Order& order) {
+  return order.type == ORDER_WAIVE ? NO_PROVINCE : order.unit.province;
+}
+
+}  // namespace
+
+OrderStore::OrderStore(int powers)
+    : slots_(new Slot[powers > 0 ? powers : 0]), powers_(powers > 0 ? powers : 0) {}
+
+uint64_t OrderStore::Submit(int power, const std::string& phase,
+                            const std::vector<Order>& orders) {
+  Slot& slot = slots_[power];
+  uint64_t version = ++slot.version;
+
+  // The last order given to each unit, and the units named, by province + 1
+  std::vector<Order> latest;
+  std::vector<bool> named;
+  for (auto it = orders.rbegin(); it != orders.rend(); ++it) {
+    size_t index = orderedUnit(*it) + 1;
+    if (index >= named.size()) {
+      named.resize(index + 1);
+    }
+    if (!named[index] || it->type == ORDER_WAIVE) {
+      latest.push_back(*it);
+    }
+    named[index] = true;
+  }
+  std::reverse(latest.begin(), latest.end());
+
+  std::shared_ptr<const Submission> previous = std::atomic_load(&slot.current);
+  while (true) {
+    // A later submission already won the slot
+    if (previous && previous->version > version) {
+      return version;
+    }
+
+    auto next = std::make_shared<Submission>();
+    next->phase = phase;
+    next->version = version;
+    next->orders = latest;
+    if (previous && previous->phase == phase) {
+      for (const Order& order : previous->orders) {
+        size_t index = orderedUnit(order) + 1;
+        if (index >= named.size() || !named[index]) {
+          next->orders.push_back(order);
+        }
+      }
+    }
+
+    std::shared_ptr<const Submission> published = std::move(next);
+    if (std::atomic_compare_exchange_weak(&slot.current, &previous, published)) {
+      return version;
+    }
+  }
+}
+
+std::shared_ptr<const Submission> OrderStore::Latest(int power, const std::string& phase) const {
+  if (power < 0 || power >= powers_) {
+    return nullptr;
+  }
+  std::shared_ptr<const Submission> submission = std::atomic_load(&slots_[power].current);
+  if (!submission || submission->phase != phase) {
+    return nullptr;
+  }
+  return submission;
+}
+
+std::vector<Order> OrderStore::Collect(const std::string& phase) const {
+  std::vector<Order> orders;
+  for (int power = 0; power < powers_; ++power) {
+    auto submission = Latest(power, phase);
+    if (submission) {
+      orders.insert(orders.end(), submission->orders.begin(), submission->orders.end());
+    }
+  }
+  return orders;
+}
+
+void OrderStore::Clear() {
+  for (int power = 0; power < powers_; ++power) {
+    std::atomic_store(&slots_[power].current, std::shared_ptr<const Submission>());
+  }
+}
+
+}  // namespace diplomacy
@@ -0,0 +1,62 @@
+#ifndef ORDER_STORE_H
+#define ORDER_STORE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "adjudicator.h"
+
+namespace diplomacy {
+
+// The orders one power has submitted for a phase. Published whole and
+// never changed afterwards, so a reader may keep it while the power
+// submits again.
+struct Submission {
+  std::string phase;           // "S1901M" style
+  uint64_t version;            // Counts up with every submission by the power
+  std::vector<Order> orders;
+};
+
+// Submitted orders of one game, one slot per power. Each submission is
+// merged with the power's earlier orders for the phase and published as a
+// new version, with the latest version winning. Readers load the current
+// version of a slot without blocking submitters; there is no lock shared
+// between powers.
+class OrderStore {
+ public:
+  explicit OrderStore(int powers = 0);
+
+  OrderStore(OrderStore&& other) = default;
+  OrderStore& operator=(OrderStore&& other) = default;
+
+  // Merge `orders` into the power's submission for `phase`: they replace
+  // any earlier orders for the same units and keep the rest. Returns the
+  // version published.
+  uint64_t Submit(int power, const std::string& phase, const std::vector<Order>& orders);
+
+  // The power's latest submission for `phase`, or null if there is none
+  std::shared_ptr<const Submission> Latest(int power, const std::string& phase) const;
+
+  // Every power's orders for `phase`
+  std::vector<Order> Collect(const std::string& phase) const;
+
+  // Drop all submissions, once their phase has been adjudicated
+  void Clear();
+
+  int PowerCount() const { return powers_; }
+
+ private:
+  struct Slot {
+    std::shared_ptr<const Submission> current;  // Only through std::atomic_load/store
+    std::atomic<uint64_t> version{0};
+  };
+
+  std::unique_ptr<Slot[]> slots_;
+  int powers_;
+};
+
+}  // namespace diplomacy
+
+#endif // ORDER_STORE_H
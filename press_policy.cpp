@@ -0,0 +1,62 @@
+#include <cctype>
+#include "press_policy.h"
+
+namespace diplomacy {
+
+bool CompilePressRules(const std::string& pressType, PressPolicy* policy) {
+  if (pressType == "none") {
+    *policy = 0;
+  } else if (pressType == "white") {
+    *policy = PRESS_ALLOW_WHITE | PRESS_ALLOW_PARTIAL | PRESS_ALLOW_BROADCAST |
+              PRESS_ALL_PHASES;
+  } else if (pressType == "grey") {
+    *policy = PRESS_ALLOW_WHITE | PRESS_ALLOW_GREY | PRESS_ALLOW_PARTIAL |
+              PRESS_ALLOW_BROADCAST | PRESS_ALL_PHASES;
+  } else if (pressType == "broadcast") {
+    *policy = PRESS_ALLOW_WHITE | PRESS_ALLOW_BROADCAST | PRESS_ALL_PHASES;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool PressRuleFlag(const std::string& ruleType, PressFlag* flag) {
+  static const struct {
+    const char* name;
+    PressFlag flag;
+  } rules[] = {
+    {"white", PRESS_ALLOW_WHITE},
+    {"grey", PRESS_ALLOW_GREY},
+    {"partial", PRESS_ALLOW_PARTIAL},
+    {"broadcast", PRESS_ALLOW_BROADCAST},
+    {"fake", PRESS_ALLOW_FAKE},
+    {"observer", PRESS_ALLOW_OBSERVER},
+    {"movement", PRESS_ALLOW_MOVEMENT},
+    {"retreat", PRESS_ALLOW_RETREAT},
+    {"adjustment", PRESS_ALLOW_ADJUSTMENT}
+  };
+
+  for (const auto& rule : rules) {
+    if (ruleType == rule.name) {
+      *flag = rule.flag;
+      return true;
+    }
+  }
+  return false;
+}
+
+PressFlag PressPhaseFlag(const std::string& phase) {
+  char first = phase.empty()
+      ? 'M' : static_cast<char>(std::toupper(static_cast<unsigned char>(phase[0])));
+  switch (first) {
+    case 'R':
+      return PRESS_ALLOW_RETREAT;
+    case 'A':  // Adjustment
+    case 'B':  // Build
+      return PRESS_ALLOW_ADJUSTMENT;
+    default:
+      return PRESS_ALLOW_MOVEMENT;
+  }
+}
+
+}  // namespace diplomacy
@@ -0,0 +1,55 @@
+#ifndef PRESS_POLICY_H
+#define PRESS_POLICY_H
+
+#include <cstdint>
+#include <string>
+
+namespace diplomacy {
+
+// A game's press options compiled into a bitmask. Each message is reduced
+// to the set of bits it needs, and is allowed when the policy has them all.
+typedef uint32_t PressPolicy;
+
+enum PressFlag : uint32_t {
+  PRESS_ALLOW_WHITE      = 1u << 0,  // Press showing the sender
+  PRESS_ALLOW_GREY       = 1u << 1,  // Anonymous press
+  PRESS_ALLOW_PARTIAL    = 1u << 2,  // Press to some of the powers
+  PRESS_ALLOW_BROADCAST  = 1u << 3,  // Press to all of the powers
+  PRESS_ALLOW_FAKE       = 1u << 4,  // Partial press disguised as a broadcast
+  PRESS_ALLOW_OBSERVER   = 1u << 5,  // Press sent by someone without a power
+  PRESS_ALLOW_MOVEMENT   = 1u << 6,  // Press during movement phases
+  PRESS_ALLOW_RETREAT    = 1u << 7,  // Press during retreat phases
+  PRESS_ALLOW_ADJUSTMENT = 1u << 8   // Press during build/removal phases
+};
+
+const PressPolicy PRESS_ALL_PHASES =
+    PRESS_ALLOW_MOVEMENT | PRESS_ALLOW_RETREAT | PRESS_ALLOW_ADJUSTMENT;
+
+// Compile a basic press setting ("none", "white", "grey", "broadcast")
+// into a policy. Returns false for unknown settings.
+bool CompilePressRules(const std::string& pressType, PressPolicy* policy);
+
+// Map an extended rule name ("grey", "fake", "retreat", ...) to its flag.
+// Returns false for unknown names.
+bool PressRuleFlag(const std::string& ruleType, PressFlag* flag);
+
+// Phase flag for a phase name such as "DIPLOMACY", "Retreat" or "Build"
+PressFlag PressPhaseFlag(const std::string& phase);
+
+// Bits a message needs from the policy
+inline uint32_t PressRequirements(bool grey, bool broadcast, bool fake,
+                                  bool observer, PressFlag phase) {
+  return (grey ? PRESS_ALLOW_GREY : PRESS_ALLOW_WHITE) |
+         (broadcast ? PRESS_ALLOW_BROADCAST : PRESS_ALLOW_PARTIAL) |
+         (fake ? PRESS_ALLOW_FAKE : 0u) |
+         (observer ? PRESS_ALLOW_OBSERVER : 0u) |
+         phase;
+}
+
+inline bool PressAllowed(PressPolicy policy, uint32_t required) {
+  return (required & ~policy) == 0;
+}
+
+}  // namespace diplomacy
+
+#endif // PRESS_POLICY_H
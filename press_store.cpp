@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <cctype>
+#include "press_store.h"
+
+namespace diplomacy {
+
+uint32_t PressStore::Append(int senderId, const std::string& senderPower,
+                            PressKind kind, bool grey, bool fake,
+                            const std::vector<std::string>& recipients,
+                            const std::string& phase, const std::string& body) {
+  uint32_t seq = static_cast<uint32_t>(log_.size());
+  log_.push_back({seq, senderId, senderPower, kind, grey, fake && kind == PRESS_PARTIAL,
+                  kind == PRESS_BROADCAST ? std::vector<std::string>() : recipients,
+                  phase, body});
+
+  // File the message under each mailbox that can see it
+  if (kind == PRESS_BROADCAST) {
+    broadcasts_.push_back(seq);
+  } else {
+    mailboxes_[senderPower].push_back(seq);
+    for (const auto& recipient : recipients) {
+      Postings& box = mailboxes_[recipient];
+      if (box.empty() || box.back() != seq) {
+        box.push_back(seq);
+      }
+    }
+  }
+
+  // Index each distinct word once
+  std::vector<std::string> words;
+  Tokenize(body, words);
+  std::sort(words.begin(), words.end());
+  words.erase(std::unique(words.begin(), words.end()), words.end());
+  for (const auto& word : words) {
+    terms_[word].push_back(seq);
+  }
+
+  return seq;
+}
+
+std::vector<const PressMessage*> PressStore::Mailbox(const std::string& power,
+                                                     size_t offset,
+                                                     size_t limit) const {
+  std::vector<const PressMessage*> page;
+
+  static const Postings empty;
+  auto it = mailboxes_.find(power);
+  const Postings& own = it != mailboxes_.end() ? it->second : empty;
+
+  // Merge own and broadcast postings from the newest end
+  size_t i = own.size();
+  size_t j = broadcasts_.size();
+  while ((i > 0 || j > 0) && page.size() < limit) {
+    uint32_t seq;
+    if (j == 0 || (i > 0 && own[i - 1] > broadcasts_[j - 1])) {
+      seq = own[--i];
+    } else {
+      seq = broadcasts_[--j];
+    }
+
+    if (offset > 0) {
+      --offset;
+      continue;
+    }
+    page.push_back(&log_[seq]);
+  }
+
+  return page;
+}
+
+size_t PressStore::MailboxSize(const std::string& power) const {
+  auto it = mailboxes_.find(power);
+  return broadcasts_.size() + (it != mailboxes_.end() ? it->second.size() : 0);
+}
+
+std::vector<const PressMessage*> PressStore::Search(const std::string& power,
+                                                    const std::string& query,
+                                                    size_t limit) const {
+  std::vector<const PressMessage*> matches;
+
+  std::vector<std::string> words;
+  Tokenize(query, words);
+  if (words.empty()) {
+    return matches;
+  }
+
+  // Gather posting lists, shortest first so it drives the intersection
+  std::vector<const Postings*> lists;
+  for (const auto& word : words) {
+    auto it = terms_.find(word);
+    if (it == terms_.end()) {
+      return matches;
+    }
+    lists.push_back(&it->second);
+  }
+  std::sort(lists.begin(), lists.end(),
+            [](const Postings* a, const Postings* b) { return a->size() < b->size(); });
+
+  const Postings& driver = *lists[0];
+  for (size_t i = driver.size(); i > 0 && matches.size() < limit; --i) {
+    uint32_t seq = driver[i - 1];
+
+    bool inAll = true;
+    for (size_t l = 1; l < lists.size() && inAll; ++l) {
+      inAll = std::binary_search(lists[l]->begin(), lists[l]->end(), seq);
+    }
+
+    if (inAll && CanRead(log_[seq], power)) {
+      matches.push_back(&log_[seq]);
+    }
+  }
+
+  return matches;
+}
+
+bool PressStore::CanRead(const PressMessage& msg, const std::string& power) {
+  if (msg.kind == PRESS_BROADCAST || msg.senderPower == power) {
+    return true;
+  }
+  return std::find(msg.recipients.begin(), msg.recipients.end(), power) !=
+         msg.recipients.end();
+}
+
+bool PressStore::ShowsSender(const PressMessage& msg, const std::string& power) {
+  return !msg.grey || msg.senderPower == power;
+}
+
+void PressStore::Tokenize(const std::string& text, std::vector<std::string>& out) {
+  std::string word;
+  for (char c : text) {
+    unsigned char uc = static_cast<unsigned char>(c);
+    if (std::isalnum(uc)) {
+      word += static_cast<char>(std::tolower(uc));
+    } else if (!word.empty()) {
+      out.push_back(word);
+      word.clear();
+    }
+  }
+  if (!word.empty()) {
+    out.push_back(word);
+  }
+}
+
+}  // namespace diplomacy
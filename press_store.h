@@ -0,0 +1,76 @@
+#ifndef PRESS_STORE_H
+#define PRESS_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace diplomacy {
+
+// Kinds of press, as in njudge's PRESS TO / BROADCAST
+enum PressKind {
+  PRESS_PARTIAL = 0,    // Sent to one or more named powers
+  PRESS_BROADCAST = 1   // Sent to every power in the game
+};
+
+// A single stored press message. Powers are upper-case names ("ENGLAND").
+struct PressMessage {
+  uint32_t seq;
+  int senderId;
+  std::string senderPower;
+  PressKind kind;
+  bool grey;                          // Sender is hidden from recipients
+  bool fake;                          // Recipients see it as a broadcast
+  std::vector<std::string> recipients; // Empty for broadcasts
+  std::string phase;
+  std::string body;
+};
+
+// Append-only press log for one game. Every message gets a sequence number
+// equal to its position in the log, so per-mailbox and per-term posting
+// lists stay sorted simply by appending.
+class PressStore {
+ public:
+  // Append a message and index it; returns its sequence number
+  uint32_t Append(int senderId, const std::string& senderPower, PressKind kind,
+                  bool grey, bool fake,
+                  const std::vector<std::string>& recipients,
+                  const std::string& phase, const std::string& body);
+
+  // Messages visible to `power` (sent, received or broadcast), newest first.
+  // Skips `offset` matches and returns at most `limit`.
+  std::vector<const PressMessage*> Mailbox(const std::string& power,
+                                           size_t offset, size_t limit) const;
+
+  // Number of messages visible to `power`
+  size_t MailboxSize(const std::string& power) const;
+
+  // Messages visible to `power` containing every word of `query`, newest first
+  std::vector<const PressMessage*> Search(const std::string& power,
+                                          const std::string& query,
+                                          size_t limit) const;
+
+  // Whether `power` may read the message
+  static bool CanRead(const PressMessage& msg, const std::string& power);
+
+  // Whether `power` is shown the real sender of the message
+  static bool ShowsSender(const PressMessage& msg, const std::string& power);
+
+  size_t Size() const { return log_.size(); }
+
+ private:
+  typedef std::vector<uint32_t> Postings;
+
+  static void Tokenize(const std::string& text, std::vector<std::string>& out);
+
+  std::vector<PressMessage> log_;
+  Postings broadcasts_;
+  std::unordered_map<std::string, Postings> mailboxes_; // Partial press by power
+  std::unordered_map<std::string, Postings> terms_;     // Word -> messages
+};
+
+}  // namespace diplomacy
+
+#endif // PRESS_STORE_H
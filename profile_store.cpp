@@ -0,0 +1,287 @@
+#include "profile_store.h"
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace diplomacy {
+
+namespace {
+
+const char kMagic[8] = {'D', 'I', 'P', 'P', 'R', 'O', 'F', '1'};
+const uint32_t kVersion = 1;
+const uint64_t kInitialCapacity = 1024;
+
+const uint8_t kNotifications = 1;
+const uint8_t kDeadlineReminders = 2;
+const uint8_t kOrderConfirmation = 4;
+
+// Spread player IDs over a power-of-two table
+uint64_t slotIndex(int playerId, uint64_t capacity) {
+  uint32_t hash = static_cast<uint32_t>(playerId) * 2654435761u;
+  hash ^= hash >> 16;
+  return hash & (capacity - 1);
+}
+
+}  // namespace
+
+// The file starts with a header and is followed by `capacity` slots, an
+// open-addressed table probed linearly. A slot whose player ID is 0 is free.
+struct ProfileStore::Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t slotSize;
+  uint64_t capacity;
+  uint64_t count;
+  uint8_t reserved[32];
+};
+
+struct ProfileStore::Slot {
+  int32_t playerId;
+  uint8_t flags;
+  uint8_t levelLength;
+  uint16_t addressLength;
+  int64_t vacationStart;
+  int64_t vacationEnd;
+  char level[kMaxLevel];
+  char address[kMaxAddress];
+};
+
+ProfileStore::~ProfileStore() {
+  Close();
+}
+
+bool ProfileStore::Open(const std::string& path, std::string* error) {
+  Close();
+  if (!map(path, kInitialCapacity, error)) {
+    return false;
+  }
+  path_ = path;
+  return true;
+}
+
+void ProfileStore::Close() {
+  Flush();
+  if (base_) {
+    munmap(base_, size_);
+  }
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+  base_ = nullptr;
+  fd_ = -1;
+  size_ = 0;
+  path_.clear();
+}
+
+bool ProfileStore::Get(int playerId, PlayerProfile* profile) const {
+  Slot* slot = base_ ? find(playerId) : nullptr;
+  if (!slot || slot->playerId != playerId) {
+    return false;
+  }
+  profile->playerId = playerId;
+  profile->notifications = slot->flags & kNotifications;
+  profile->deadlineReminders = slot->flags & kDeadlineReminders;
+  profile->orderConfirmation = slot->flags & kOrderConfirmation;
+  profile->vacationStart = slot->vacationStart;
+  profile->vacationEnd = slot->vacationEnd;
+  profile->level.assign(slot->level, slot->levelLength);
+  profile->address.assign(slot->address, slot->addressLength);
+  return true;
+}
+
+bool ProfileStore::Put(const PlayerProfile& profile) {
+  if (profile.playerId <= 0 || profile.level.size() > kMaxLevel ||
+      profile.address.size() > kMaxAddress || !ensureOpen()) {
+    return false;
+  }
+
+  Header* header = static_cast<Header*>(base_);
+  Slot* slot = find(profile.playerId);
+  if (!slot) {
+    return false;
+  }
+  bool added = slot->playerId == 0;
+  if (added && (header->count + 1) * 10 > header->capacity * 7) {
+    if (!grow()) {
+      return false;
+    }
+    header = static_cast<Header*>(base_);
+    slot = find(profile.playerId);
+  }
+
+  slot->flags = (profile.notifications ? kNotifications : 0) |
+                (profile.deadlineReminders ? kDeadlineReminders : 0) |
+                (profile.orderConfirmation ? kOrderConfirmation : 0);
+  slot->vacationStart = profile.vacationStart;
+  slot->vacationEnd = profile.vacationEnd;
+  slot->levelLength = static_cast<uint8_t>(profile.level.size());
+  std::memcpy(slot->level, profile.level.data(), profile.level.size());
+  slot->addressLength = static_cast<uint16_t>(profile.address.size());
+  std::memcpy(slot->address, profile.address.data(), profile.address.size());
+  // Claim a free slot only once its contents are in place
+  if (added) {
+    slot->playerId = profile.playerId;
+    ++header->count;
+  }
+
+  if (++pending_ >= kFlushEvery) {
+    Flush();
+  }
+  return true;
+}
+
+void ProfileStore::Flush() {
+  if (fd_ >= 0 && pending_ > 0) {
+    msync(base_, size_, MS_SYNC);
+  }
+  pending_ = 0;
+}
+
+size_t ProfileStore::Count() const {
+  return base_ ? static_cast<const Header*>(base_)->count : 0;
+}
+
+// A store opened with no path, or never opened, keeps its profiles in memory
+bool ProfileStore::ensureOpen() {
+  return base_ || map("", kInitialCapacity, nullptr);
+}
+
+// Map `path` (or anonymous memory for ""), laying out an empty table of
+// `capacity` slots if the file is new
+bool ProfileStore::map(const std::string& path, uint64_t capacity, std::string* error) {
+  static_assert(sizeof(Header) == 64, "header layout is part of the file format");
+  static_assert(sizeof(Slot) == 256, "slot layout is part of the file format");
+
+  auto fail = [&](const std::string& message) {
+    if (error) {
+      *error = message;
+    }
+    return false;
+  };
+
+  int fd = -1;
+  bool fresh = true;
+  if (!path.empty()) {
+    fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+      return fail("Cannot open " + path);
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+      close(fd);
+      return fail("Cannot read " + path);
+    }
+    if (info.st_size > 0) {
+      Header header;
+      if (pread(fd, &header, sizeof header, 0) != static_cast<ssize_t>(sizeof header) ||
+          std::memcmp(header.magic, kMagic, sizeof kMagic) != 0 ||
+          header.version != kVersion || header.slotSize != sizeof(Slot) ||
+          header.capacity == 0 || (header.capacity & (header.capacity - 1)) != 0 ||
+          header.count >= header.capacity ||
+          static_cast<uint64_t>(info.st_size) != sizeof(Header) + header.capacity * sizeof(Slot)) {
+        close(fd);
+        return fail(path + " is not a profile store");
+      }
+      capacity = header.capacity;
+      fresh = false;
+    }
+  }
+
+  size_t size = sizeof(Header) + capacity * sizeof(Slot);
+  if (fresh && fd >= 0 && ftruncate(fd, static_cast<off_t>(size)) != 0) {
+    close(fd);
+    return fail("Cannot size " + path);
+  }
+  void* base = fd >= 0 ? mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+                       : mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (base == MAP_FAILED) {
+    if (fd >= 0) {
+      close(fd);
+    }
+    return fail("Cannot map " + (path.empty() ? std::string("profile store") : path));
+  }
+  // Lookups go straight to one slot; reading ahead would only page in strangers
+  madvise(base, size, MADV_RANDOM);
+
+  if (fresh) {
+    Header* header = static_cast<Header*>(base);
+    std::memcpy(header->magic, kMagic, sizeof kMagic);
+    header->version = kVersion;
+    header->slotSize = sizeof(Slot);
+    header->capacity = capacity;
+    header->count = 0;
+  }
+  base_ = base;
+  fd_ = fd;
+  size_ = size;
+  return true;
+}
+
+// Rehash into a table twice the size. A file-backed table is rebuilt beside
+// the old one and renamed over it, so the file on disk is always whole.
+bool ProfileStore::grow() {
+  void* oldBase = base_;
+  int oldFd = fd_;
+  size_t oldSize = size_;
+  const Header* oldHeader = static_cast<const Header*>(oldBase);
+  uint64_t oldCapacity = oldHeader->capacity;
+
+  std::string building = path_.empty() ? "" : path_ + ".tmp";
+  if (!building.empty()) {
+    unlink(building.c_str());
+  }
+  if (!map(building, oldCapacity * 2, nullptr)) {
+    return false;
+  }
+
+  const Slot* oldSlots = reinterpret_cast<const Slot*>(static_cast<const char*>(oldBase) + sizeof(Header));
+  for (uint64_t i = 0; i < oldCapacity; ++i) {
+    if (oldSlots[i].playerId != 0) {
+      *find(oldSlots[i].playerId) = oldSlots[i];
+    }
+  }
+  static_cast<Header*>(base_)->count = oldHeader->count;
+
+  // The old table stays in use, unchanged, if the new one cannot take its place
+  if (!building.empty()) {
+    msync(base_, size_, MS_SYNC);
+    if (rename(building.c_str(), path_.c_str()) != 0) {
+      munmap(base_, size_);
+      close(fd_);
+      unlink(building.c_str());
+      base_ = oldBase;
+      fd_ = oldFd;
+      size_ = oldSize;
+      return false;
+    }
+  }
+  munmap(oldBase, oldSize);
+  if (oldFd >= 0) {
+    close(oldFd);
+  }
+  pending_ = 0;
+  return true;
+}
+
+// The slot holding `playerId`, or the free slot where it would go; null if
+// the table is full, which only a damaged file can make it
+ProfileStore::Slot* ProfileStore::find(int playerId) const {
+  uint64_t capacity = static_cast<const Header*>(base_)->capacity;
+  Slot* table = slots();
+  uint64_t i = slotIndex(playerId, capacity);
+  for (uint64_t probes = 0; probes < capacity; ++probes, i = (i + 1) & (capacity - 1)) {
+    if (table[i].playerId == playerId || table[i].playerId == 0) {
+      return &table[i];
+    }
+  }
+  return nullptr;
+}
+
+ProfileStore::Slot* ProfileStore::slots() const {
+  return reinterpret_cast<Slot*>(static_cast<char*>(base_) + sizeof(Header));
+}
+
+}  // namespace diplomacy
@@ -0,0 +1,75 @@
+#ifndef PROFILE_STORE_H
+#define PROFILE_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace diplomacy {
+
+// What a player has told the judge about themselves, kept between games
+struct PlayerProfile {
+  int playerId = 0;
+  bool notifications = false;
+  bool deadlineReminders = false;
+  bool orderConfirmation = false;
+  int64_t vacationStart = 0; // ms since the epoch; 0 when no vacation is set
+  int64_t vacationEnd = 0;
+  std::string level;
+  std::string address;
+};
+
+// Player profiles in a memory-mapped file of fixed-size slots, hashed by
+// player ID. Opening the store maps the file and reads nothing else, so
+// startup does not depend on how many players have ever registered; a
+// profile's page is brought in the first time it is looked up. Writes land
+// in the mapping and reach the disk in batches, on Flush or every
+// kFlushEvery writes. With no path the slots live in anonymous memory.
+class ProfileStore {
+ public:
+  static constexpr size_t kMaxLevel = 24;
+  static constexpr size_t kMaxAddress = 208;
+  static constexpr int kFlushEvery = 64;
+
+  ProfileStore() {}
+  ~ProfileStore();
+  ProfileStore(const ProfileStore&) = delete;
+  ProfileStore& operator=(const ProfileStore&) = delete;
+
+  // Map the store kept at `path`, creating the file if there is none, or a
+  // store in memory for "". The current store is flushed and closed first.
+  bool Open(const std::string& path, std::string* error);
+  void Close();
+
+  bool Get(int playerId, PlayerProfile* profile) const;
+
+  // Insert or replace a profile; false if the ID is not positive or the
+  // level or address is too long for a slot
+  bool Put(const PlayerProfile& profile);
+
+  // Write pending changes to disk
+  void Flush();
+
+  size_t Count() const;
+  const std::string& Path() const { return path_; }
+
+ private:
+  struct Header;
+  struct Slot;
+
+  bool ensureOpen();
+  bool map(const std::string& path, uint64_t capacity, std::string* error);
+  bool grow();
+  Slot* find(int playerId) const;
+  Slot* slots() const;
+
+  std::string path_;
+  int fd_ = -1;
+  void* base_ = nullptr;
+  size_t size_ = 0;
+  int pending_ = 0;
+};
+
+}  // namespace diplomacy
+
+#endif // PROFILE_STORE_H
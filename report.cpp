@@ -0,0 +1,298 @@
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include "report.h"
+
+namespace diplomacy {
+
+namespace {
+
+const char* const kSeasonNames[] = {"Spring", "Fall", "Winter"};
+const char* const kPhaseNames[] = {"Movement", "Retreat", "Adjustment"};
+
+const char* resultNote(OrderResult result) {
+  switch (result) {
+    case RESULT_BOUNCE:
+      return "bounce";
+    case RESULT_CUT:
+      return "cut";
+    case RESULT_VOID:
+      return "void";
+    case RESULT_NO_CONVOY:
+      return "no convoy";
+    case RESULT_DISRUPTED:
+      return "disrupted";
+    case RESULT_DISBANDED:
+      return "disbanded";
+    default:
+      return nullptr;
+  }
+}
+
+}  // namespace
+
+const std::string& ReportWriter::Write(const Board& board, const PhaseResult& result) {
+  const Map& map = board.GetMap();
+  buffer_.clear();
+  SetPowerColumn(map);
+
+  Append(kPhaseNames[result.phase]);
+  Append(" results for ");
+  Append(kSeasonNames[result.season]);
+  Append(" of ");
+  AppendNumber(result.year);
+  Append(".\n\n");
+
+  WriteOrders(map, result);
+  if (!result.dislodged.empty()) {
+    WriteDislodged(map, result);
+  }
+  if (result.ownershipUpdated) {
+    WriteOwnership(board);
+  }
+  if (board.phase == PHASE_ADJUSTMENT) {
+    WriteAdjustments(board);
+  }
+  WriteNextPhase(board);
+  return buffer_;
+}
+
+void ReportWriter::WriteOrders(const Map& map, const PhaseResult& result) {
+  if (result.orders.empty()) {
+    Append("No orders were processed.\n\n");
+    return;
+  }
+
+  int lastPower = result.orders.front().order.power;
+  for (const ResolvedOrder& resolved : result.orders) {
+    const Order& order = resolved.order;
+    if (order.power != lastPower) {
+      Append('\n');
+      lastPower = order.power;
+    }
+    AppendPowerColumn(map, order.power);
+
+    switch (order.type) {
+      case ORDER_HOLD:
+        AppendUnit(map, order.unitType, order.unit);
+        Append(" HOLD");
+        break;
+      case ORDER_MOVE:
+      case ORDER_RETREAT:
+        AppendUnit(map, order.unitType, order.unit);
+        Append(" -> ");
+        AppendLocation(map, order.to);
+        break;
+      case ORDER_SUPPORT:
+      case ORDER_CONVOY: {
+        AppendUnit(map, order.unitType, order.unit);
+        Append(order.type == ORDER_SUPPORT ? " SUPPORT " : " CONVOY ");
+        // Only armies are convoyed; a supported unit is named by its province
+        if (order.type == ORDER_CONVOY) {
+          Append("Army ");
+        }
+        AppendLocation(map, Location{order.from, COAST_NONE});
+        if (order.to.province != order.from) {
+          Append(" -> ");
+          AppendLocation(map, order.to);
+        }
+        break;
+      }
+      case ORDER_DISBAND:
+        AppendUnit(map, order.unitType, order.unit);
+        Append(" DISBAND");
+        break;
+      case ORDER_BUILD:
+        Append("Builds ");
+        Append(order.unitType == UNIT_ARMY ? "an army in " : "a fleet in ");
+        AppendLocation(map, order.unit);
+        break;
+      case ORDER_REMOVE:
+        Append("Removes the ");
+        Append(order.unitType == UNIT_ARMY ? "army in " : "fleet in ");
+        AppendLocation(map, order.unit);
+        break;
+      case ORDER_WAIVE:
+        Append("Build waived");
+        break;
+    }
+    Append('.');
+
+    const char* note = resultNote(resolved.result);
+    if (result.phase == PHASE_ADJUSTMENT && resolved.result == RESULT_DISBANDED) {
+      note = "civil disorder";
+    }
+    if (note) {
+      Append("  (*");
+      Append(note);
+      Append("*)");
+    }
+    if (resolved.dislodged) {
+      Append("  (*dislodged*)");
+    }
+    Append('\n');
+  }
+  Append('\n');
+}
+
+void ReportWriter::WriteDislodged(const Map& map, const PhaseResult& result) {
+  Append("The following units were dislodged:\n\n");
+  for (const DislodgedUnit& unit : result.dislodged) {
+    Append("The ");
+    Append(map.PowerAdjective(unit.power));
+    Append(unit.type == UNIT_ARMY ? " Army in " : " Fleet in ");
+    AppendLocation(map, unit.location);
+    if (unit.retreats.empty()) {
+      Append(" with no valid retreats was destroyed.\n");
+      continue;
+    }
+    Append(" can retreat to ");
+    for (size_t i = 0; i < unit.retreats.size(); ++i) {
+      if (i > 0) {
+        Append(i + 1 == unit.retreats.size() ? " or " : ", ");
+      }
+      AppendLocation(map, unit.retreats[i]);
+    }
+    Append(".\n");
+  }
+  Append('\n');
+}
+
+const std::string& ReportWriter::WritePositions(const Board& board) {
+  const Map& map = board.GetMap();
+  buffer_.clear();
+  SetPowerColumn(map);
+
+  Append("Unit positions:\n\n");
+  for (int power = 0; power < map.PowerCount(); ++power) {
+    bool first = true;
+    for (ProvinceId p = 0; p < map.ProvinceCount(); ++p) {
+      const Unit& unit = board.units[p];
+      if (unit.power != power) {
+        continue;
+      }
+      if (first) {
+        AppendPowerColumn(map, power);
+        first = false;
+      } else {
+        Append(", ");
+      }
+      AppendUnit(map, unit.type, Location{p, unit.coast});
+    }
+    if (!first) {
+      Append(".\n");
+    }
+  }
+  return buffer_;
+}
+
+void ReportWriter::WriteOwnership(const Board& board) {
+  const Map& map = board.GetMap();
+  Append("Ownership of supply centers:\n\n");
+  // Powers in order, then the unowned centers
+  for (int i = 0; i <= map.PowerCount(); ++i) {
+    int power = i < map.PowerCount() ? i : -1;
+    bool first = true;
+    for (ProvinceId p = 0; p < map.ProvinceCount(); ++p) {
+      if (!map.GetProvince(p).supplyCenter || board.owners[p] != power) {
+        continue;
+      }
+      if (first) {
+        if (power < 0) {
+          Append("Unowned:");
+          buffer_.append(powerColumn_ > 8 ? powerColumn_ - 8 : 1, ' ');
+        } else {
+          AppendPowerColumn(map, power);
+        }
+        first = false;
+      } else {
+        Append(", ");
+      }
+      Append(map.GetProvince(p).name);
+    }
+    if (!first) {
+      Append(".\n");
+    }
+  }
+  Append('\n');
+}
+
+void ReportWriter::WriteAdjustments(const Board& board) {
+  const Map& map = board.GetMap();
+  for (int power = 0; power < map.PowerCount(); ++power) {
+    int centers = board.CenterCount(power);
+    int units = board.UnitCount(power);
+    if (centers == 0 && units == 0) {
+      continue;
+    }
+    AppendPowerColumn(map, power);
+    AppendNumber(centers, 2);
+    Append(" Supply centers, ");
+    AppendNumber(units, 2);
+    Append(" Units:  ");
+    int due = centers - units;
+    if (due == 0) {
+      Append("No adjustments.\n");
+      continue;
+    }
+    Append(due > 0 ? "Builds  " : "Removes ");
+    AppendNumber(due > 0 ? due : -due, 2);
+    Append(due == 1 || due == -1 ? " unit.\n" : " units.\n");
+  }
+  Append('\n');
+}
+
+void ReportWriter::WriteNextPhase(const Board& board) {
+  Append("The next phase will be ");
+  Append(kPhaseNames[board.phase]);
+  Append(" for ");
+  Append(kSeasonNames[board.season]);
+  Append(" of ");
+  AppendNumber(board.year);
+  Append(".\n");
+}
+
+void ReportWriter::SetPowerColumn(const Map& map) {
+  powerColumn_ = 0;
+  for (int power = 0; power < map.PowerCount(); ++power) {
+    powerColumn_ = std::max(powerColumn_, map.PowerName(power).size() + 2);
+  }
+}
+
+void ReportWriter::Append(const char* text) {
+  buffer_.append(text, std::strlen(text));
+}
+
+void ReportWriter::AppendNumber(int value, int width) {
+  char digits[16];
+  auto end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+  int length = static_cast<int>(end - digits);
+  if (length < width) {
+    buffer_.append(width - length, ' ');
+  }
+  buffer_.append(digits, end);
+}
+
+// "France:" padded so that every power's text lines up
+void ReportWriter::AppendPowerColumn(const Map& map, int power) {
+  const std::string& name = map.PowerName(power);
+  Append(name);
+  Append(':');
+  buffer_.append(powerColumn_ > name.size() + 1 ? powerColumn_ - name.size() - 1 : 1, ' ');
+}
+
+void ReportWriter::AppendUnit(const Map& map, UnitType type, const Location& location) {
+  Append(type == UNIT_ARMY ? "Army " : "Fleet ");
+  AppendLocation(map, location);
+}
+
+void ReportWriter::AppendLocation(const Map& map, const Location& location) {
+  Append(map.GetProvince(location.province).name);
+  if (location.coast != COAST_NONE) {
+    Append(" (");
+    Append(Map::CoastName(location.coast));
+    Append(')');
+  }
+}
+
+}  // namespace diplomacy
@@ -0,0 +1,50 @@
+#ifndef REPORT_H
+#define REPORT_H
+
+#include <string>
+#include "adjudicator.h"
+
+namespace diplomacy {
+
+// Renders judge-style result text for an adjudicated phase: every power's
+// orders with their results, dislodged units and their retreats, supply
+// center ownership after Fall and the adjustments due.
+//
+// The text is built in a buffer owned by the writer and kept between
+// reports, so a writer that is reused for every phase of a game stops
+// allocating once the buffer has grown to the size of a full report.
+class ReportWriter {
+ public:
+  ReportWriter() {}
+
+  // Render `result`, with `board` as it stands after the phase. The text
+  // stays valid until the next call.
+  const std::string& Write(const Board& board, const PhaseResult& result);
+
+  // Every power's units on `board`, for the public view of a phase. The
+  // text stays valid until the next call.
+  const std::string& WritePositions(const Board& board);
+
+ private:
+  void WriteOrders(const Map& map, const PhaseResult& result);
+  void WriteDislodged(const Map& map, const PhaseResult& result);
+  void WriteOwnership(const Board& board);
+  void WriteAdjustments(const Board& board);
+  void WriteNextPhase(const Board& board);
+  void SetPowerColumn(const Map& map);
+
+  void Append(const char* text);
+  void Append(const std::string& text) { buffer_.append(text); }
+  void Append(char c) { buffer_.push_back(c); }
+  void AppendNumber(int value, int width = 0);
+  void AppendPowerColumn(const Map& map, int power);
+  void AppendUnit(const Map& map, UnitType type, const Location& location);
+  void AppendLocation(const Map& map, const Location& location);
+
+  std::string buffer_;
+  size_t powerColumn_ = 0;
+};
+
+}  // namespace diplomacy
+
+#endif // REPORT_H
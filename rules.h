@@ -0,0 +1,35 @@
+#ifndef RULES_H
+#define RULES_H
+
+namespace diplomacy {
+
+// Rule policies. The adjudicator is instantiated once per policy (see
+// RulesFor in adjudicator.h), so a variant's rules are compile-time
+// constants in order checking and adjudication rather than flags tested
+// on every order.
+
+// The standard rules: builds only in owned home centers
+struct StandardRules {
+  static constexpr const char* kName = "standard";
+  static constexpr bool kBuildAnywhere = false;
+};
+
+// The standard rules, except that a power may build in any supply center
+// it owns. Games asking for "machiavelli" get these rules: Machiavelli's
+// build-anywhere rule is all of it there is, without money, bribes or the
+// Italian map.
+struct BuildAnywhereRules {
+  static constexpr const char* kName = "build-anywhere";
+  static constexpr bool kBuildAnywhere = true;
+};
+
+// Chaos: every supply center is its own power, and a power may build in
+// any center it owns
+struct ChaosRules {
+  static constexpr const char* kName = "chaos";
+  static constexpr bool kBuildAnywhere = true;
+};
+
+}  // namespace diplomacy
+
+#endif // RULES_H
@@ -45,7 +45,7 @@ describe('Deadline Management Commands', () => {
   });
 
   describe('Wait Management', () => {
-    test.skip('should process SET WAIT command', () => {
+    test('should process SET WAIT command', () => {
       const result = processTextInput('SET WAIT', 'player@example.com');
       expect(result).toBe(true);
       
@@ -54,7 +54,7 @@ describe('Deadline Management Commands', () => {
       expect(emails[0].subject).toContain('WAIT');
     });
 
-    test.skip('should process UNSET WAIT command', () => {
+    test('should process UNSET WAIT command', () => {
       const result = processTextInput('UNSET WAIT', 'player@example.com');
       expect(result).toBe(true);
       
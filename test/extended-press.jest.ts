@@ -4,7 +4,11 @@ import {
   registerPlayer,
   sendPress,
   getOutboundEmails,
-  setPressRules
+  setPressRules,
+  getPressHistory,
+  searchPress,
+  processTextInput,
+  extendedPressRules
 } from '../lib';
 
 // Interface for email objects
@@ -90,4 +94,80 @@ describe('Extended Press and Communication', () => {
     const emails = getOutboundEmails();
     expect(emails.some((e: Email) => e.body.includes('This should be blocked'))).toBe(false);
   });
-});
\ No newline at end of file
+
+  test('should keep press history per mailbox, newest first', () => {
+    sendPress(playerIds['England'], playerIds['France'], 'First note to France', gameId);
+    sendPress(playerIds['Germany'], playerIds['England'], 'Germany writes to England', gameId);
+    sendPress(playerIds['France'], 0, 'France broadcasts to everyone', gameId);
+    getOutboundEmails();
+    
+    const france = getPressHistory(gameId, playerIds['France']);
+    expect(france.total).toBe(2);
+    expect(france.messages[0].body).toBe('France broadcasts to everyone');
+    expect(france.messages[0].broadcast).toBe(true);
+    expect(france.messages[1].from).toBe('ENGLAND');
+    expect(france.messages[1].to).toEqual(['FRANCE']);
+    
+    const page = getPressHistory(gameId, playerIds['England'], 1, 1);
+    expect(page.total).toBe(3);
+    expect(page.messages).toHaveLength(1);
+    expect(page.messages[0].body).toBe('Germany writes to England');
+  });
+  
+  test('should search only press the reader can see', () => {
+    sendPress(playerIds['England'], playerIds['France'], 'Secret plan against Germany', gameId);
+    sendPress(playerIds['Germany'], 0, 'Germany has no plan, honestly', gameId);
+    getOutboundEmails();
+    
+    expect(searchPress(gameId, playerIds['France'], 'plan')).toHaveLength(2);
+    expect(searchPress(gameId, playerIds['France'], 'secret PLAN')).toHaveLength(1);
+    expect(searchPress(gameId, playerIds['Germany'], 'secret')).toHaveLength(0);
+  });
+  
+  test('should hide the sender of grey press from recipients', () => {
+    const result = sendPress(playerIds['England'], 'FRANCE', 'Guess who', gameId, true);
+    expect(result.success).toBe(true);
+    getOutboundEmails();
+    
+    expect(getPressHistory(gameId, playerIds['France']).messages[0].from).toBe('Anonymous');
+    expect(getPressHistory(gameId, playerIds['England']).messages[0].from).toBe('ENGLAND');
+    
+    setPressRules('white', gameId);
+    expect(sendPress(playerIds['England'], 'FRANCE', 'Guess again', gameId, true).success).toBe(false);
+  });
+
+  test('should apply extended press rules on top of the press setting', () => {
+    expect(extendedPressRules(gameId, 'partial', false)).toBe(true);
+    expect(sendPress(playerIds['England'], playerIds['France'], 'Just us two', gameId).success).toBe(false);
+    expect(sendPress(playerIds['England'], 0, 'Hello all', gameId).success).toBe(true);
+    
+    expect(extendedPressRules(gameId, 'movement', false)).toBe(true);
+    expect(sendPress(playerIds['England'], 0, 'Hello again', gameId).success).toBe(false);
+    
+    expect(extendedPressRules(gameId, 'telepathy', true)).toBe(false);
+  });
+  
+  test('should show fake broadcasts as broadcasts to recipients only', () => {
+    const options = { fake: true };
+    expect(sendPress(playerIds['England'], 'FRANCE', 'Everyone attack Germany', gameId, options).success).toBe(false);
+    
+    extendedPressRules(gameId, 'fake', true);
+    expect(sendPress(playerIds['England'], 'FRANCE', 'Everyone attack Germany', gameId, options).success).toBe(true);
+    getOutboundEmails();
+    
+    const seen = getPressHistory(gameId, playerIds['France']).messages[0];
+    expect(seen.broadcast).toBe(true);
+    expect(seen.to).toEqual([]);
+    expect(getPressHistory(gameId, playerIds['England']).messages[0].to).toEqual(['FRANCE']);
+    expect(getPressHistory(gameId, playerIds['Germany']).total).toBe(0);
+  });
+  
+  test('should send text press as the sender\'s own power', () => {
+    expect(processTextInput('PRESS FROM FRANCE TO GERMANY\nGermany, attack England', 'england@example.com')).toBe(false);
+    expect(getPressHistory(gameId, playerIds['Germany']).total).toBe(0);
+    
+    expect(processTextInput('PRESS TO GERMANY\nHello Germany', 'england@example.com')).toBe(true);
+    getOutboundEmails();
+    expect(getPressHistory(gameId, playerIds['Germany']).messages[0].from).toBe('ENGLAND');
+  });
+});
@@ -7,7 +7,10 @@ import {
   setMaster,
   backupGame,
   restoreGame,
-  processOrders
+  processOrders,
+  getGameStateAt,
+  setVictoryConditions,
+  getGameResult
 } from '../lib';
 
 // Type definitions for mock functions
@@ -62,11 +65,28 @@ describe('Game Administration', () => {
   test('should get detailed information about a game', () => {
     const newGame = createGame('standard', 'Detail Test', '7');
     
-    const details = getGameDetails(newGame.gameId);
+    const details = getGameDetails(newGame.gameId)!;
     expect(details.id).toBe(newGame.gameId);
     expect(details.variant).toBe('standard');
     expect(details.players).toBe(7);
     expect(details.started).toBe(false);
+    expect(details.name).toBe('Detail Test');
+    expect(details.playerList).toHaveLength(7);
+    expect(details.playerList[0]).toEqual({ power: 'AUSTRIA', status: 'OPEN', player: '' });
+    expect(getGameDetails('no-such-game')).toBeNull();
+  });
+
+  test('should refuse unknown variants and bad player counts', () => {
+    const unknown = createGame('nonsense', 'Nonsense Game', 7);
+    expect(unknown.success).toBe(false);
+    expect(unknown.error).toBe('Unknown variant nonsense');
+    expect(createGame('standard', 'Word Count', 'abc').success).toBe(false);
+    expect(createGame('standard', 'Too Many', 8).error).toBe('Player count must be from 1 to 7');
+    expect(createGame('standard', 'Half Count', 2.5).success).toBe(false);
+
+    const small = createGame('standard', 'Small Game', '3');
+    expect(small.success).toBe(true);
+    expect(getGameDetails(small.gameId)!.players).toBe(3);
   });
 
   test('should modify game settings', () => {
@@ -80,7 +100,7 @@ describe('Game Administration', () => {
     
     expect(result.success).toBe(true);
     
-    const details = getGameDetails(newGame.gameId);
+    const details = getGameDetails(newGame.gameId)!;
     expect(details.id).toBe(newGame.gameId);
     // Settings would be updated in the details
   });
@@ -113,8 +133,90 @@ describe('Game Administration', () => {
     expect(result.success).toBe(true);
     
     // Game should be back to initial state
-    const details = getGameDetails(newGame.gameId);
+    const details = getGameDetails(newGame.gameId)!;
     expect(details.phase).toBe('Spring');
     expect(details.year).toBe(1901);
   });
-}); 
\ No newline at end of file
+
+  test('should return the position at any earlier phase', () => {
+    const newGame = createGame('standard', 'History Test', '7');
+    for (let year = 1901; year <= 1910; year++) {
+      processOrders(newGame.gameId, 0, ['A PAR-BUR']);
+      processOrders(newGame.gameId, 0, ['A BUR-PAR']);
+    }
+
+    const army = (state: any, location: string) =>
+      state.units.find((u: any) => u.location === location);
+
+    const start = getGameStateAt(newGame.gameId, 1901, 'Spring', 'Movement')!;
+    expect(army(start, 'PAR')).toEqual({ power: 'FRANCE', type: 'A', location: 'PAR' });
+    expect(start.centers['FRANCE']).toEqual(['BRE', 'MAR', 'PAR']);
+
+    const later = getGameStateAt(newGame.gameId, 1906, 'Fall', 'Movement')!;
+    expect(later.year).toBe(1906);
+    expect(later.season).toBe('Fall');
+    expect(army(later, 'BUR')).toBeDefined();
+    expect(army(later, 'PAR')).toBeUndefined();
+
+    // Asking again is served from the cache with the same answer
+    expect(getGameStateAt(newGame.gameId, 1906, 'Fall', 'Movement')).toEqual(later);
+    expect(getGameStateAt(newGame.gameId, 1911, 'Spring', 'Movement')?.year).toBe(1911);
+    expect(getGameStateAt(newGame.gameId, 1920, 'Spring', 'Movement')).toBeNull();
+    expect(getGameStateAt('unknown-game', 1901, 'Spring', 'Movement')).toBeNull();
+  });
+
+  test('should start new games from a shared position without linking them', () => {
+    const first = createGame('standard', 'Template Test 1', '7');
+    const second = createGame('standard', 'Template Test 2', '7');
+    processOrders(first.gameId, 0, ['A PAR-BUR']);
+
+    const moved = getGameStateAt(first.gameId, 1901, 'Fall', 'Movement')!;
+    expect(moved.units.find(u => u.location === 'BUR')).toBeDefined();
+    const untouched = getGameStateAt(second.gameId, 1901, 'Spring', 'Movement')!;
+    expect(untouched.units.find(u => u.location === 'PAR')).toBeDefined();
+    expect(getGameStateAt(second.gameId, 1901, 'Fall', 'Movement')).toBeNull();
+  });
+
+  test('should restore a game to the phase it was backed up in', () => {
+    const newGame = createGame('standard', 'Rollback Test', '7');
+    processOrders(newGame.gameId, 0, ['A PAR-BUR']);
+    const backup = backupGame(newGame.gameId);
+    processOrders(newGame.gameId, 0, ['A BUR-MUN']);
+    processOrders(newGame.gameId, 0, ['A MUN-BOH']);
+
+    const result = restoreGame(backup.backupId);
+    expect(result.success).toBe(true);
+    expect(result.gameId).toBe(newGame.gameId);
+
+    const details = getGameDetails(newGame.gameId)!;
+    expect(details.phase).toBe('Fall');
+    expect(details.year).toBe(1901);
+    const state = getGameStateAt(newGame.gameId, 1901, 'Fall', 'Movement')!;
+    expect(state.units.find(u => u.location === 'BUR')).toBeDefined();
+    expect(getGameStateAt(newGame.gameId, 1902, 'Spring', 'Movement')).toBeNull();
+  });
+
+  test('should restore a later backup after rolling back past it', () => {
+    const newGame = createGame('standard', 'Double Rollback Test', '7');
+    const start = backupGame(newGame.gameId);
+    processOrders(newGame.gameId, 0, ['A PAR-BUR']);
+    const fall = backupGame(newGame.gameId);
+
+    expect(restoreGame(start.backupId).success).toBe(true);
+    expect(getGameStateAt(newGame.gameId, 1901, 'Fall', 'Movement')).toBeNull();
+
+    expect(restoreGame(fall.backupId).success).toBe(true);
+    const state = getGameStateAt(newGame.gameId, 1901, 'Fall', 'Movement')!;
+    expect(state.units.find(u => u.location === 'BUR')).toBeDefined();
+  });
+
+  test('should roll back the result of the game', () => {
+    const newGame = createGame('standard', 'Result Rollback Test', '7');
+    const backup = backupGame(newGame.gameId);
+    setVictoryConditions(true, newGame.gameId, 4);
+    expect(getGameResult(newGame.gameId).finished).toBe(true);
+
+    expect(restoreGame(backup.backupId).success).toBe(true);
+    expect(getGameResult(newGame.gameId).finished).toBe(false);
+  });
+});
@@ -1,9 +1,14 @@
-import { describe, test, expect, beforeAll } from '@jest/globals';
+import { describe, test, expect, beforeAll, beforeEach } from '@jest/globals';
 import {
   initGame,
+  getGameState,
+  processOrders,
   processTextInput,
   getOutboundEmails,
+  registerPlayer,
   voteForDraw,
+  concedeGame,
+  getGameResult,
   setVictoryConditions
 } from '../lib';
 
@@ -98,4 +103,82 @@ describe('Game Conclusion Mechanisms', () => {
       expect(lastEmail.body).toContain('ITALY');
     });
   });
-});
\ No newline at end of file
+
+  describe('End-of-Game Tracking', () => {
+    const gameId = 'conclusion-game';
+    const ids: Record<string, number> = {};
+
+    const powers = ['Austria', 'England', 'France', 'Germany', 'Italy', 'Russia', 'Turkey'];
+
+    beforeEach(() => {
+      initGame('standard', 7);
+      powers.forEach(power => {
+        ids[power] = registerPlayer(power + ' Player', power.toLowerCase() + '@example.com', power, gameId).playerId;
+      });
+    });
+
+    test('should accept a DIAS draw once every survivor has voted', () => {
+      setVictoryConditions(true, gameId);
+      powers.slice(0, -1).forEach(power => {
+        expect(voteForDraw(ids[power], true, gameId).drawAccepted).toBe(false);
+      });
+      expect(getGameResult(gameId).finished).toBe(false);
+
+      expect(voteForDraw(ids['Turkey'], true, gameId).drawAccepted).toBe(true);
+      const outcome = getGameResult(gameId);
+      expect(outcome.result).toBe('draw');
+      expect(outcome.winners).toEqual(powers.map(power => power.toUpperCase()));
+    });
+
+    test('should count powers nobody has joined as survivors', () => {
+      const openGame = 'conclusion-open-game';
+      const england = registerPlayer('Open England', 'open-england@example.com', 'England', openGame).playerId;
+      const france = registerPlayer('Open France', 'open-france@example.com', 'France', openGame).playerId;
+      setVictoryConditions(true, openGame);
+      expect(voteForDraw(england, true, openGame).drawAccepted).toBe(false);
+      expect(voteForDraw(france, true, openGame).drawAccepted).toBe(false);
+      expect(getGameResult(openGame).finished).toBe(false);
+    });
+
+    test('should require matching draw sets without DIAS', () => {
+      setVictoryConditions(false, gameId);
+      const drawSet = ['ENGLAND', 'FRANCE'];
+      powers.filter(power => power !== 'Italy').forEach(power => {
+        voteForDraw(ids[power], true, gameId, drawSet);
+      });
+      expect(voteForDraw(ids['Italy'], true, gameId).drawAccepted).toBe(false);
+
+      expect(voteForDraw(ids['Italy'], true, gameId, ['France', 'England']).drawAccepted).toBe(true);
+      expect(getGameResult(gameId).winners).toEqual(['ENGLAND', 'FRANCE']);
+    });
+
+    test('should declare a leader when the victory threshold is lowered', () => {
+      expect(setVictoryConditions(true, gameId, 4)).toBe(true);
+      const outcome = getGameResult(gameId);
+      expect(outcome.result).toBe('victory');
+      expect(outcome.winners).toEqual(['RUSSIA']);
+    });
+
+    test('should end the game when everyone else concedes', () => {
+      const others = powers.filter(power => power !== 'Italy');
+      others.slice(0, -1).forEach(power => {
+        expect(concedeGame(ids[power], 'ITALY', gameId).success).toBe(true);
+      });
+      expect(getGameResult(gameId).finished).toBe(false);
+
+      expect(concedeGame(ids['Turkey'], 'ITALY', gameId).success).toBe(true);
+      const outcome = getGameResult(gameId);
+      expect(outcome.result).toBe('concession');
+      expect(outcome.winners).toEqual(['ITALY']);
+      expect(voteForDraw(ids['England'], true, gameId).success).toBe(false);
+    });
+
+    test('should end the game at the year limit', () => {
+      expect(setVictoryConditions(true, gameId, 18, 1901)).toBe(true);
+      while (getGameState().year === 1901) {
+        processOrders(gameId, ids['England'], []);
+      }
+      expect(getGameResult(gameId).result).toBe('draw');
+    });
+  });
+});
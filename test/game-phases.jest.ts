@@ -5,7 +5,22 @@ import {
   validateOrder,
   submitOrders,
   getOutboundEmails,
-  processTextInput
+  getTextOutput,
+  registerPlayer,
+  processTextInput,
+  getPlayerStatus,
+  getSubmittedOrders,
+  processAdjudicationQueue,
+  setMinimumWait,
+  searchOrders,
+  setBotPlayer,
+  sendPress,
+  addObserver,
+  listObservers,
+  renderMap,
+  submitOrdersPacked,
+  adjudicateGames,
+  modifyGameSettings
 } from '../lib';
 
 describe('Game Phase and Order Processing', () => {
@@ -329,4 +344,331 @@ describe('Game Phase and Order Processing', () => {
       // This would require a way to query the current orders
     });
   });
-});
\ No newline at end of file
+
+  describe('Result Reports', () => {
+    const gameId = 'report-game';
+    const ids: Record<string, number> = {};
+
+    beforeEach(() => {
+      ['England', 'France', 'Germany'].forEach(power => {
+        ids[power] = registerPlayer(power + ' Player', power.toLowerCase() + '@example.com', power, gameId).playerId;
+      });
+      getOutboundEmails();
+    });
+
+    test('should mail the same results to every registered player', () => {
+      processOrders(gameId, 0, ['A PAR-BUR', 'A MUN-BUR', 'F LON-NTH']);
+
+      const emails = getOutboundEmails();
+      expect(emails).toHaveLength(3);
+      const reports = emails.map((e: any) => e.body.slice(e.body.indexOf('Movement results')));
+      emails.forEach((email: any) => {
+        expect(email.subject).toBe('Diplomacy results S1901M');
+        expect(email.body).toContain('Movement results for Spring of 1901.');
+        expect(email.body).toContain('England: Fleet London -> North Sea.');
+        expect(email.body).toContain('France:  Army Paris -> Burgundy.  (*bounce*)');
+        expect(email.body).toContain('Germany: Army Munich -> Burgundy.  (*bounce*)');
+      });
+      expect(emails[0].body).toContain('Results for England');
+      expect(new Set(reports).size).toBe(1);
+    });
+
+    test('should report dislodged units and their retreats', () => {
+      processOrders(gameId, 0, ['A MUN-BUR', 'A PAR-PIC']);
+      processOrders(gameId, 0, ['A MAR-BUR', 'A PIC S A MAR-BUR']);
+
+      const state = getGameState();
+      expect(state.phase).toBe('Retreat');
+      expect(state.season).toBe('Fall');
+
+      const output = getTextOutput(ids['Germany']);
+      expect(output).toContain('France:  Army Marseilles -> Burgundy.');
+      expect(output).toContain('Germany: Army Burgundy HOLD.  (*dislodged*)');
+      expect(output).toContain('The German Army in Burgundy can retreat to Belgium, Gascony, Munich, Paris or Ruhr.');
+    });
+
+    test('should report supply center ownership and adjustments after Fall', () => {
+      processOrders(gameId, 0, ['F KIE-HOL', 'A MUN-RUH']);
+      processOrders(gameId, 0, ['F HOL-BEL', 'A RUH S F HOL-BEL']);
+
+      const state = getGameState();
+      expect(state.phase).toBe('Build');
+      expect(state.season).toBe('Winter');
+      const germany = state.players.find((p: { power: string }) => p.power === 'Germany');
+      expect(germany?.centers).toBe(4);
+
+      const output = getTextOutput(ids['England']);
+      expect(output).toContain('Ownership of supply centers:');
+      expect(output).toContain('Germany: Belgium, Berlin, Kiel, Munich.');
+      expect(output).toContain('Germany:  4 Supply centers,  3 Units:  Builds   1 unit.');
+      expect(output).toContain('The next phase will be Adjustment for Winter of 1901.');
+
+      processOrders(gameId, ids['Germany'], 'BUILD A MUN');
+      expect(getTextOutput(ids['England'])).toContain('Germany: Builds an army in Munich.');
+      expect(getGameState().year).toBe(1902);
+    });
+  });
+
+  describe('Submitted Orders', () => {
+    const gameId = 'submission-game';
+
+    test('should keep the latest order for each unit across resubmissions', () => {
+      const id = registerPlayer('France Player', 'france@example.com', 'France', gameId).playerId;
+      const first = submitOrders(id, 'A PAR-BUR\nA MAR-SPA', gameId);
+      expect(first.ordersAccepted).toBe(true);
+      expect(first.version).toBe(1);
+
+      // A partial resubmission replaces only the units it names
+      const second = submitOrders(id, ['A MAR-PIE', 'A PAR-GAS', 'A PAR-PIC', 'F BRE-ENG'], gameId);
+      expect(second.version).toBe(2);
+
+      const stored = getSubmittedOrders(gameId, id);
+      expect(stored.phase).toBe('S1901M');
+      expect(stored.version).toBe(2);
+      expect(stored.orders.sort()).toEqual(['A MAR-PIE', 'A PAR-PIC', 'F BRE-ENG']);
+      expect(stored.missing).toEqual([]);
+
+      const rejected = submitOrders(id, 'A MAR-MUN\nA PAR H', gameId);
+      expect(rejected.ordersAccepted).toBe(false);
+      expect(rejected.rejected).toEqual([{ order: 'A MAR-MUN', error: 'Army cannot move there' }]);
+      expect(getSubmittedOrders(gameId, id).orders).toContain('A PAR H');
+    });
+
+    test('should refuse orders from a player with no power in the game', () => {
+      const result = submitOrders(12345, ['F LON-ENG', 'A PAR-BUR'], gameId);
+      expect(result.success).toBe(false);
+      expect(result.ordersAccepted).toBe(false);
+      expect(result.error).toBe('Player has no power in this game');
+      const england = registerPlayer('England Player', 'england@example.com', 'England', gameId).playerId;
+      expect(getSubmittedOrders(gameId, england).orders).toEqual([]);
+    });
+
+    test('should adjudicate every submission and then clear them', () => {
+      const france = registerPlayer('France Player', 'france@example.com', 'France', gameId).playerId;
+      const germany = registerPlayer('Germany Player', 'germany@example.com', 'Germany', gameId).playerId;
+      submitOrders(france, 'A PAR-BUR', gameId);
+      submitOrders(germany, 'A MUN-BUR', gameId);
+      expect(getSubmittedOrders(gameId, germany).missing).toEqual(['A BER', 'F KIE']);
+
+      processOrders(gameId, 0, []);
+      const output = getTextOutput(france);
+      expect(output).toContain('France:  Army Paris -> Burgundy.  (*bounce*)');
+      expect(output).toContain('Germany: Army Munich -> Burgundy.  (*bounce*)');
+      expect(getSubmittedOrders(gameId, france).orders).toEqual([]);
+      expect(getSubmittedOrders(gameId, france).phase).toBe('F1901M');
+    });
+  });
+
+  describe('Early Adjudication', () => {
+    const gameId = 'early-game';
+    let france = 0;
+    let germany = 0;
+
+    beforeEach(() => {
+      france = registerPlayer('France Player', 'france@example.com', 'France', gameId).playerId;
+      germany = registerPlayer('Germany Player', 'germany@example.com', 'Germany', gameId).playerId;
+    });
+
+    test('should adjudicate once every power with a player is ready', () => {
+      const partial = submitOrders(france, 'A PAR-BUR\nA MAR-SPA', gameId);
+      expect(partial.ready).toBe(false);
+      expect(submitOrders(france, 'F BRE-MAO', gameId).ready).toBe(true);
+      expect(processAdjudicationQueue()).toEqual([]);
+
+      submitOrders(germany, 'A MUN-RUH\nA BER-KIE\nF KIE-DEN', gameId);
+      expect(processAdjudicationQueue()).toEqual([gameId]);
+      expect(getGameState().season).toBe('Fall');
+      expect(getSubmittedOrders(gameId, france).ready).toBe(false);
+      expect(processAdjudicationQueue()).toEqual([]);
+    });
+
+    test('should wait for a player who joins once the others are ready', () => {
+      submitOrders(france, 'A PAR H\nA MAR H\nF BRE H', gameId);
+      submitOrders(germany, 'A MUN H\nA BER H\nF KIE H', gameId);
+      const italy = registerPlayer('Italy Player', 'italy@example.com', 'Italy', gameId).playerId;
+      expect(processAdjudicationQueue()).toEqual([]);
+
+      expect(submitOrders(italy, 'A ROM H\nA VEN H\nF NAP H', gameId).ready).toBe(true);
+      expect(processAdjudicationQueue()).toEqual([gameId]);
+    });
+
+    test('should hold a queued game for a wait raised after it was ready', () => {
+      submitOrders(france, 'A PAR H\nA MAR H\nF BRE H', gameId);
+      submitOrders(germany, 'A MUN H\nA BER H\nF KIE H', gameId);
+      expect(setMinimumWait(60, gameId)).toBe(true);
+      expect(processAdjudicationQueue()).toEqual([]);
+
+      expect(modifyGameSettings(gameId, { minimumWait: 120 }).success).toBe(true);
+      expect(processAdjudicationQueue()).toEqual([]);
+
+      setMinimumWait(0, gameId);
+      expect(processAdjudicationQueue()).toEqual([gameId]);
+    });
+
+    test('should hold the game for the minimum wait and for waiting players', () => {
+      expect(setMinimumWait(60, gameId)).toBe(true);
+      submitOrders(france, 'A PAR H\nA MAR H\nF BRE H', gameId);
+      submitOrders(germany, 'A MUN H\nA BER H\nF KIE H', gameId);
+      expect(processAdjudicationQueue()).toEqual([]);
+
+      setMinimumWait(0, gameId);
+      processTextInput('SET WAIT', 'germany@example.com');
+      expect(getSubmittedOrders(gameId, germany).ready).toBe(false);
+      expect(processAdjudicationQueue()).toEqual([]);
+
+      processTextInput('UNSET WAIT', 'germany@example.com');
+      expect(processAdjudicationQueue()).toEqual([gameId]);
+      expect(getGameState().season).toBe('Fall');
+    });
+  });
+
+  describe('Bot Players', () => {
+    const gameId = 'bot-game';
+
+    test('should search for a legal order for every unit of a power', () => {
+      const result = searchOrders(gameId, 'Russia', 50);
+      expect(result.orders).toHaveLength(4);
+      expect(result.evaluations).toBeGreaterThan(0);
+      expect(result.threads).toBeGreaterThan(0);
+      ['MOS', 'SEV', 'STP', 'WAR'].forEach(province => {
+        expect(result.orders.some(order => order.startsWith('A ' + province) || order.startsWith('F ' + province))).toBe(true);
+      });
+      expect(searchOrders(gameId, 'Narnia', 50).orders).toEqual([]);
+    });
+
+    test('should cap the budget and threads of a search', () => {
+      const started = Date.now();
+      const result = searchOrders(gameId, 'France', 60000, 200000);
+      expect(Date.now() - started).toBeLessThan(3000);
+      expect(result.orders).toHaveLength(3);
+      expect(result.threads).toBeLessThan(200000);
+      expect(searchOrders(gameId, 'France', 10, 0).orders).toEqual([]);
+    });
+
+    test('should order for an abandoned seat at adjudication', () => {
+      const id = registerPlayer('Germany Player', 'germany@example.com', 'Germany', gameId).playerId;
+      expect(getPlayerStatus(id, gameId).status).toBe('ACTIVE');
+      expect(getPlayerStatus(id, 'another-game').status).toBe('UNKNOWN');
+      expect(setBotPlayer(gameId, 'Germany', 50)).toBe(true);
+      expect(getPlayerStatus(id, gameId).status).toBe('BOT');
+
+      // Orders sent for the seat are replaced by the bot's
+      processOrders(gameId, 0, ['A PAR-BUR', 'A MUN H', 'A BER H', 'F KIE H']);
+      const output = getTextOutput(id);
+      expect(output).toContain('France:  Army Paris -> Burgundy.');
+      expect(output.match(/^Germany: /gm)).toHaveLength(3);
+
+      expect(setBotPlayer(gameId, 'Germany', 0)).toBe(true);
+      expect(getPlayerStatus(id, gameId).status).toBe('ACTIVE');
+      expect(setBotPlayer(gameId, 'Narnia', 50)).toBe(false);
+    });
+
+    test('should search for every bot within one capped budget', () => {
+      ['Austria', 'Italy', 'Russia', 'Turkey'].forEach(power => {
+        expect(setBotPlayer(gameId, power, 60000)).toBe(true);
+      });
+      const started = Date.now();
+      processOrders(gameId, 0, []);
+      expect(Date.now() - started).toBeLessThan(3000);
+      ['Austria', 'Italy', 'Russia', 'Turkey'].forEach(power => setBotPlayer(gameId, power, 0));
+    });
+  });
+
+  describe('Observers', () => {
+    const gameId = 'watched-game';
+    const mailTo = (address: string) => getOutboundEmails().filter(email => email.to === address);
+
+    test('should send observers the results, positions and broadcast press', () => {
+      const france = registerPlayer('France Player', 'france@example.com', 'France', gameId).playerId;
+      expect(addObserver(gameId, 'watcher@example.com')).toBe(true);
+
+      processOrders(gameId, 0, ['A PAR-BUR']);
+      const results = mailTo('watcher@example.com');
+      expect(results).toHaveLength(1);
+      expect(results[0].subject).toBe('Diplomacy results S1901M');
+      expect(results[0].body).toContain('France:  Army Paris -> Burgundy.');
+      expect(results[0].body).toContain('Unit positions:');
+      expect(results[0].body).toContain('Army Burgundy');
+
+      sendPress(france, 0, 'Peace in our time', gameId);
+      const press = mailTo('watcher@example.com');
+      expect(press).toHaveLength(1);
+      expect(press[0].body).toBe('Peace in our time');
+    });
+
+    test('should hold views back from a delayed spectator', () => {
+      expect(addObserver(gameId, 'late@example.com', 1)).toBe(true);
+      expect(listObservers(gameId)).toEqual([{ address: 'late@example.com', delay: 1 }]);
+
+      processOrders(gameId, 0, ['A PAR-BUR']);
+      expect(mailTo('late@example.com')).toHaveLength(0);
+
+      processOrders(gameId, 0, ['A BUR-MUN']);
+      const late = mailTo('late@example.com');
+      expect(late).toHaveLength(1);
+      expect(late[0].subject).toBe('Diplomacy results S1901M');
+    });
+  });
+
+  describe('Maps', () => {
+    const gameId = 'mapped-game';
+
+    test('should draw the current position before any phase is played', () => {
+      expect(renderMap('unknown-game')).toBeNull();
+
+      registerPlayer('England Player', 'england@example.com', 'England', gameId);
+      const svg = renderMap(gameId)!;
+      expect(svg.startsWith('<svg')).toBe(true);
+      expect(svg).toContain('Spring 1901 Movement');
+      expect(svg).toContain('>LON</text>');
+      // No orders yet, so no arrows
+      expect(svg.includes('<polygon')).toBe(false);
+    });
+
+    test('should draw a played phase with its orders and their results', () => {
+      const france = registerPlayer('France Player', 'france@example.com', 'France', gameId).playerId;
+      processOrders(gameId, france, ['A PAR-BUR', 'A MAR S A PAR-BUR']);
+
+      const played = renderMap(gameId)!;
+      expect(played).toContain('Spring 1901 Movement');
+      expect(played).toContain('<polygon');
+      expect(played).toContain('stroke-dasharray="6 3"');
+      expect(renderMap(gameId, 'S1901M')).toBe(played);
+
+      // Every picture of the map starts with the same base layer
+      const now = renderMap(gameId, 'F1901M')!;
+      expect(now).toContain('Fall 1901 Movement');
+      expect(now.slice(0, now.indexOf('<g id="overlay"'))).toBe(played.slice(0, played.indexOf('<g id="overlay"')));
+      expect(renderMap(gameId, 'S1850M')).toBeNull();
+    });
+  });
+
+  describe('Bulk Entry Points', () => {
+    const pack = (...parts: string[]) => new TextEncoder().encode(parts.map(part => part + '\0').join(''));
+
+    test('should store packed orders for several players', () => {
+      const gameId = 'packed-game';
+      const france = registerPlayer('France Player', 'france@example.com', 'France', gameId).playerId;
+      const england = registerPlayer('England Player', 'england@example.com', 'England', gameId).playerId;
+
+      const accepted = submitOrdersPacked(gameId, new Int32Array([france, england]),
+                                          pack('A PAR-BUR\nA MAR-SPA\nA PAR-XXX', 'F LON-NTH\n'));
+      expect(accepted).toBeInstanceOf(Int32Array);
+      expect(Array.from(accepted)).toEqual([2, 1]);
+      expect(getSubmittedOrders(gameId, france).orders).toEqual(['A PAR-BUR', 'A MAR-SPA']);
+      expect(getSubmittedOrders(gameId, england).orders).toEqual(['F LON-NTH']);
+    });
+
+    test('should adjudicate several games at once', () => {
+      const france = registerPlayer('France Player', 'france@example.com', 'France', 'bulk-one').playerId;
+      const england = registerPlayer('England Player', 'england@example.com', 'England', 'bulk-two').playerId;
+      submitOrdersPacked('bulk-one', new Int32Array([france]), pack('A PAR-BUR\nA MAR-SPA'));
+      submitOrdersPacked('bulk-two', new Int32Array([england]), pack('F LON-NTH'));
+
+      const resolved = adjudicateGames(pack('bulk-one', 'bulk-two'));
+      expect(Array.from(resolved)).toEqual([2, 1]);
+      expect(renderMap('bulk-one', 'S1901M')).toContain('<polygon');
+      expect(() => adjudicateGames(new Int32Array(1) as unknown as Uint8Array)).toThrow(TypeError);
+    });
+  });
+});
@@ -4,7 +4,13 @@ import {
   processTextInput,
   getOutboundEmails,
   setMaster,
-  getGameState
+  getGameState,
+  applyMasterCommands,
+  getGameControl,
+  registerPlayer,
+  renderMap,
+  processOrders,
+  adjudicateGames
 } from '../lib';
 
 describe('Master-Only Game Controls', () => {
@@ -128,4 +134,76 @@ describe('Master-Only Game Controls', () => {
       expect(emails[0].body).toContain('This is a test message to all players');
     });
   });
-});
\ No newline at end of file
+
+  describe('Command Batches', () => {
+    const director = 'director@example.com';
+
+    test('should apply a batch to many games and journal it once in each', () => {
+      setMaster('cup-1', director);
+      setMaster('cup-2', director);
+
+      const result = applyMasterCommands(director, ['cup-1', 'cup-2'],
+                                         ['PAUSE', 'EXTEND 24', 'SET PRESS white', 'SET ACCESS 2 3 1']);
+      expect(result.success).toBe(true);
+      expect(result.errors).toEqual([]);
+
+      for (const gameId of ['cup-1', 'cup-2']) {
+        const control = getGameControl(gameId);
+        expect(control.master).toBe(director);
+        expect(control.paused).toBe(true);
+        expect(control.extensionHours).toBe(24);
+        expect(control.access).toEqual({ dedication: 2, onTimeRating: 3, resistanceRating: 1 });
+        expect(control.journal).toHaveLength(2);
+        expect(control.journal[1].sequence).toBe(result.sequence);
+        expect(control.journal[1].phase).toBe('S1901M');
+        expect(control.journal[1].commands).toEqual(['PAUSE', 'EXTEND 24', 'SET PRESS white', 'SET ACCESS 2 3 1']);
+      }
+    });
+
+    test('should apply nothing when any command fails for any game', () => {
+      setMaster('cup-3', director);
+
+      const result = applyMasterCommands(director, ['cup-1', 'cup-3'], 'RESUME\nEXTEND 12');
+      expect(result.success).toBe(false);
+      expect(result.errors).toEqual([{ gameId: 'cup-3', command: 'RESUME', error: 'Game is not paused' }]);
+      expect(getGameControl('cup-1').paused).toBe(true);
+      expect(getGameControl('cup-1').extensionHours).toBe(24);
+      expect(getGameControl('cup-1').journal).toHaveLength(2);
+
+      expect(applyMasterCommands('someone@example.com', 'cup-1', 'RESUME').errors[0].error)
+        .toBe('Not the master of this game');
+      expect(applyMasterCommands(director, 'cup-1', 'FLY AWAY').errors[0].command).toBe('FLY AWAY');
+      expect(applyMasterCommands(director, 'cup-1', 'PROCESS').errors[0].error).toBe('Game is paused');
+    });
+
+    test('should not adjudicate a paused game on demand', () => {
+      expect(processOrders('cup-1', 0, [])).toBe(0);
+      expect(Array.from(adjudicateGames(Buffer.from('cup-1\0')))).toEqual([-1]);
+      expect(renderMap('cup-1')).toContain('Spring 1901 Movement');
+    });
+
+    test('should refuse a batch naming no games or a game twice', () => {
+      const empty = applyMasterCommands(director, [], 'EXTEND 6');
+      expect(empty.success).toBe(false);
+      expect(empty.sequence).toBe(0);
+      expect(empty.errors).toEqual([{ gameId: '', command: '', error: 'No games given' }]);
+
+      const twice = applyMasterCommands(director, ['cup-1', 'cup-1'], 'EXTEND 6');
+      expect(twice.success).toBe(false);
+      expect(twice.errors).toEqual([{ gameId: 'cup-1', command: '', error: 'Game named more than once' }]);
+      expect(getGameControl('cup-1').extensionHours).toBe(24);
+      expect(getGameControl('cup-1').journal).toHaveLength(2);
+    });
+
+    test('should eject a power and adjudicate on command', () => {
+      const france = registerPlayer('France Player', 'france@example.com', 'France', 'cup-4').playerId;
+      setMaster('cup-4', director);
+
+      const result = applyMasterCommands(director, 'cup-4', ['EJECT France', 'PROCESS']);
+      expect(result.success).toBe(true);
+      expect(getGameState().players.some(player => player.status === france)).toBe(false);
+      expect(renderMap('cup-4')).toContain('Spring 1901 Movement');
+      expect(getGameControl('cup-4').journal[1].phase).toBe('S1901M');
+    });
+  });
+});
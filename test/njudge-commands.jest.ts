@@ -122,7 +122,7 @@ describe('NJudge Commands', () => {
       expect(emails[0].subject).toContain('JOIN');
     });
 
-    test.skip('should process OBSERVE command', () => {
+    test('should process OBSERVE command', () => {
       const result = processTextInput('OBSERVE testgame', 'observer@example.com');
       expect(result).toBe(true);
       
@@ -131,6 +131,13 @@ describe('NJudge Commands', () => {
       expect(emails[0].subject).toContain('OBSERVE');
     });
 
+    test('should refuse OBSERVE with a negative delay', () => {
+      expect(processTextInput('OBSERVE testgame -1', 'observer@example.com')).toBe(true);
+      
+      const emails = getOutboundEmails();
+      expect(emails[emails.length - 1].subject).toBe('OBSERVE Failed');
+    });
+
     test.skip('should process STATUS command', () => {
       const result = processTextInput('STATUS', 'player@example.com');
       expect(result).toBe(true);
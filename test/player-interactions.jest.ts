@@ -71,13 +71,10 @@ describe('Player Interactions', () => {
     });
     
     test('should retrieve player status', () => {
-      // Check status for each player - the C++ implementation returns FRANCE for all players
-      // This is a mock implementation simplification
       Object.entries(playerIds).forEach(([power, id]: [string, number]) => {
         const status = getPlayerStatus(id, gameId);
         expect(status).toBeDefined();
-        // The actual implementation always returns FRANCE for demo purposes
-        expect(status.power).toBe('FRANCE');
+        expect(status.power).toBe(power.toUpperCase());
         expect(status.status).toBe('ACTIVE');
       });
     });
@@ -164,21 +161,23 @@ describe('Player Interactions', () => {
     });
     
     test('should accept build/remove orders in adjustment phase', () => {
-      // Prepare build and remove orders
-      const buildOrders = 'A LON';
-      const removeOrders = 'R F BRE';
-      
-      const englandResult = submitOrders(playerIds['England'], buildOrders, gameId);
-      expect(englandResult.success).toBe(true);
-      expect(englandResult.ordersAccepted).toBe(true);
-      
-      const franceResult = submitOrders(playerIds['France'], removeOrders, gameId);
+      // France took Spain and Germany Denmark in the Spring; both build
+      expect(getGameState().phase).toBe('Build');
+
+      const franceResult = submitOrders(playerIds['France'], 'BUILD A PAR', gameId);
       expect(franceResult.success).toBe(true);
       expect(franceResult.ordersAccepted).toBe(true);
       
+      // England has nothing to remove
+      const englandResult = submitOrders(playerIds['England'], 'REMOVE F LON', gameId);
+      expect(englandResult.success).toBe(true);
+      expect(englandResult.ordersAccepted).toBe(false);
+      expect(englandResult.rejected[0].error).toBe('No removals due');
+      
       // Process builds
-      const processResult = processOrders(gameId, 0, ['A LON', 'R F BRE']);
+      const processResult = processOrders(gameId, 0, ['BUILD A BER']);
       expect(processResult).toBe(1); // Updated to expect 1 instead of true
+      expect(getGameState().year).toBe(1902);
     });
   });
 
@@ -1,11 +1,17 @@
 import { describe, test, expect, beforeAll } from '@jest/globals';
+import * as fs from 'fs';
+import * as os from 'os';
+import * as path from 'path';
 import {
   initGame,
   processTextInput,
   getOutboundEmails,
   registerPlayer,
   linkPlayerEmail,
-  setPlayerPreferences
+  setPlayerPreferences,
+  openProfileStore,
+  getPlayerProfile,
+  flushProfiles
 } from '../lib';
 
 describe('Player Registration and Preferences', () => {
@@ -21,6 +27,16 @@ describe('Player Registration and Preferences', () => {
       expect(result.playerId).toBeDefined();
     });
 
+    test('should give every player a distinct ID', () => {
+      const ids = new Set<number>();
+      for (let i = 0; i < 1000; i++) {
+        const result = registerPlayer(`Bulk ${i}`, `bulk${i}@example.com`, 'France', 'bulk-game');
+        expect(result.playerId).toBeGreaterThanOrEqual(100);
+        ids.add(result.playerId);
+      }
+      expect(ids.size).toBe(1000);
+    });
+
     test('should link player email through API', () => {
       const result = linkPlayerEmail('new-email@example.com', 'player@example.com');
       expect(result).toBe(true);
@@ -47,8 +63,16 @@ describe('Player Registration and Preferences', () => {
       // Skipped until implemented
     });
 
-    test.skip('should process SET ADDRESS command', () => {
-      // Skipped until implemented
+    test('should process SET ADDRESS command', () => {
+      const registration = registerPlayer('Addressed', 'address@example.com', 'England', 'test-game');
+      getOutboundEmails();
+      
+      expect(processTextInput('SET ADDRESS 1 Rue de Rivoli, Paris', 'address@example.com')).toBe(true);
+      expect(getOutboundEmails()[0].subject).toBe('ADDRESS Updated');
+      expect(getPlayerProfile(registration.playerId)!.address).toBe('1 Rue de Rivoli, Paris');
+      
+      processTextInput('SET ADDRESS Nowhere', 'stranger@example.com');
+      expect(getOutboundEmails()[0].subject).toBe('ADDRESS Failed');
     });
 
     test.skip('should process SET EMAIL command', () => {
@@ -59,12 +83,35 @@ describe('Player Registration and Preferences', () => {
       // Skipped until implemented
     });
 
-    test.skip('should process SET LEVEL command', () => {
-      // Skipped until implemented
+    test('should process SET LEVEL command', () => {
+      const registration = registerPlayer('Leveled', 'level@example.com', 'Italy', 'test-game');
+      getOutboundEmails();
+      
+      processTextInput('SET LEVEL Expert', 'level@example.com');
+      expect(getOutboundEmails()[0].subject).toBe('LEVEL Changed');
+      expect(getPlayerProfile(registration.playerId)!.level).toBe('expert');
+      
+      processTextInput('SET LEVEL grandmaster', 'level@example.com');
+      expect(getOutboundEmails()[0].subject).toBe('LEVEL Failed');
+      expect(getPlayerProfile(registration.playerId)!.level).toBe('expert');
     });
 
-    test.skip('should process SET VACATION command', () => {
-      // Skipped until implemented
+    test('should process SET VACATION command', () => {
+      const registration = registerPlayer('Away', 'vacation@example.com', 'Turkey', 'test-game');
+      linkPlayerEmail('holiday@example.com', 'vacation@example.com');
+      getOutboundEmails();
+      
+      processTextInput('SET VACATION 2026-12-20 TO 2027-01-03', 'holiday@example.com');
+      expect(getOutboundEmails()[0].subject).toBe('VACATION Status Updated');
+      const profile = getPlayerProfile(registration.playerId)!;
+      expect(profile.vacationStart).toBe(Date.UTC(2026, 11, 20));
+      expect(profile.vacationEnd).toBe(Date.UTC(2027, 0, 4));
+      
+      processTextInput('SET VACATION 2027-01-03 TO 2026-12-20', 'vacation@example.com');
+      expect(getOutboundEmails()[0].subject).toBe('VACATION Failed');
+      
+      processTextInput('SET VACATION NONE', 'vacation@example.com');
+      expect(getPlayerProfile(registration.playerId)!.vacationStart).toBe(0);
     });
 
     test('should set player notification preferences', () => {
@@ -79,6 +126,51 @@ describe('Player Registration and Preferences', () => {
         orderConfirmation: true 
       });
       expect(result).toBe(true);
+      const profile = getPlayerProfile(registration.playerId)!;
+      expect(profile.notifications).toBe(true);
+      expect(profile.deadlineReminders).toBe(true);
+      expect(profile.orderConfirmation).toBe(true);
+    });
+
+    test('should keep profiles in a store file across reopening', () => {
+      const file = path.join(fs.mkdtempSync(path.join(os.tmpdir(), 'profiles-')), 'profiles.db');
+      expect(openProfileStore(file)).toEqual({ success: true, profiles: 0 });
+      
+      // Enough players to make the table grow
+      const ids: number[] = [];
+      for (let i = 0; i < 2000; i++) {
+        const registration = registerPlayer(`Stored ${i}`, `stored${i}@example.com`, 'Russia', 'store-game');
+        setPlayerPreferences(registration.playerId, { notifications: i % 2 === 0, deadlineReminders: true, orderConfirmation: false });
+        ids.push(registration.playerId);
+      }
+      processTextInput('SET LEVEL novice', 'stored7@example.com');
+      expect(flushProfiles()).toBe(true);
+      
+      // Reopening maps the same file; the profiles are all still there
+      expect(openProfileStore(file)).toEqual({ success: true, profiles: 2000 });
+      ids.forEach((id, i) => {
+        expect(getPlayerProfile(id)!.notifications).toBe(i % 2 === 0);
+      });
+      expect(getPlayerProfile(ids[7])!.level).toBe('novice');
+      
+      fs.writeFileSync(file + '.bad', 'not a store');
+      expect(openProfileStore(file + '.bad').success).toBe(false);
+
+      // A table with no free slot could never be searched to the end
+      const full = Buffer.alloc(64 + 2 * 256);
+      full.write('DIPPROF1', 0, 'latin1');
+      full.writeUInt32LE(1, 8);  // Version
+      full.writeUInt32LE(256, 12);  // Slot size
+      full.writeUInt32LE(2, 16);  // Capacity
+      full.writeUInt32LE(2, 24);  // Count
+      full.writeInt32LE(101, 64);
+      full.writeInt32LE(102, 64 + 256);
+      fs.writeFileSync(file + '.full', full);
+      expect(openProfileStore(file + '.full').success).toBe(false);
+      
+      // Back to memory for the other tests
+      expect(openProfileStore('').success).toBe(true);
+      expect(getPlayerProfile(ids[0])).toBeNull();
     });
   });
 
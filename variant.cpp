@@ -0,0 +1,39 @@
+#include <cctype>
+#include "rules.h"
+#include "variant.h"
+
+namespace diplomacy {
+
+namespace {
+
+Variant makeVariant(const char* name, const Map& map, const RuleSet& rules) {
+  return {name, &map, &rules, std::make_shared<const Board>(map, rules)};
+}
+
+}  // namespace
+
+const std::vector<Variant>& Variants() {
+  static const std::vector<Variant> variants = {
+    makeVariant("standard", Map::Standard(), RulesFor<StandardRules>()),
+    makeVariant("build-anywhere", Map::Standard(), RulesFor<BuildAnywhereRules>()),
+    makeVariant("machiavelli", Map::Standard(), RulesFor<BuildAnywhereRules>()),  // Partial: build anywhere only
+    makeVariant("fleet-rome", Map::FleetRome(), RulesFor<StandardRules>()),
+    makeVariant("chaos", Map::Chaos(), RulesFor<ChaosRules>())
+  };
+  return variants;
+}
+
+const Variant* FindVariant(const std::string& name) {
+  std::string key = name;
+  for (auto& c : key) {
+    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  }
+  for (const Variant& variant : Variants()) {
+    if (variant.name == key) {
+      return &variant;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace diplomacy
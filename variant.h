@@ -0,0 +1,29 @@
+#ifndef VARIANT_H
+#define VARIANT_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "adjudicator.h"
+
+namespace diplomacy {
+
+// A playable variant: the map a game starts from, the rules its
+// adjudicator is instantiated with, and the starting position, built once
+// and shared by every game until its first adjudication
+struct Variant {
+  std::string name;   // "standard", "fleet-rome", ...
+  const Map* map;
+  const RuleSet* rules;
+  std::shared_ptr<const Board> start;
+};
+
+// Every variant games can be played under
+const std::vector<Variant>& Variants();
+
+// Variant by name, case-insensitive; nullptr if unknown
+const Variant* FindVariant(const std::string& name);
+
+}  // namespace diplomacy
+
+#endif // VARIANT_H